@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/access_matcher.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "common/string_utils.h"
+#include "common/url.h"
+#include "common/url_view.h"
+
+namespace common {
+
+namespace {
+
+// Host names are split on every '.', so "a..b" has an empty label and ""
+// is a single empty label. Comparing label sequences this way gives the
+// same answers as comparing the strings with their separating dots.
+std::vector<std::string> SplitLabels(const std::string& host) {
+  std::vector<std::string> labels;
+  size_t start = 0;
+  while (true) {
+    size_t dot = host.find('.', start);
+    if (dot == std::string::npos) {
+      labels.push_back(host.substr(start));
+      return labels;
+    }
+    labels.push_back(host.substr(start, dot - start));
+    start = dot + 1;
+  }
+}
+
+std::vector<std::string> SplitReversedLabels(const std::string& host) {
+  std::vector<std::string> labels = SplitLabels(host);
+  std::reverse(labels.begin(), labels.end());
+  return labels;
+}
+
+}  // namespace
+
+size_t AccessMatcher::LabelHash::operator()(
+    const URLComponent& label) const {
+  // FNV-1a
+  size_t hash = 2166136261u;
+  for (size_t i = 0; i < label.length; ++i) {
+    hash ^= static_cast<unsigned char>(label.data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool AccessMatcher::LabelEqual::operator()(const URLComponent& a,
+                                           const URLComponent& b) const {
+  return a.length == b.length &&
+         (a.length == 0 || memcmp(a.data, b.data, a.length) == 0);
+}
+
+AccessMatcher::Node::Node()
+    : exact(false), followed(false), anywhere(false) {
+}
+
+AccessMatcher::AccessMatcher() : allow_all_(false) {
+}
+
+AccessMatcher::~AccessMatcher() {
+}
+
+void AccessMatcher::AddWarpRule(const std::string& origin, bool subdomains) {
+  if (origin == "*") {
+    allow_all_ = true;
+    return;
+  } else if (origin.empty()) {
+    return;
+  }
+
+  URL origin_url(origin);
+  Node* root = &origins_[std::make_pair(origin_url.scheme(),
+                                        origin_url.port())];
+  Node* node = Insert(root, SplitReversedLabels(origin_url.domain()));
+  // "test.com" with subdomains also allows "aaa.test.com"
+  node->exact = true;
+  if (subdomains)
+    node->followed = true;
+}
+
+void AccessMatcher::AddNavigationRule(const std::string& pattern) {
+  std::string domain = URL(pattern).domain();
+  if (domain == "*") {
+    allow_all_ = true;
+    return;
+  }
+
+  bool prefix_wild = false;
+  bool suffix_wild = false;
+  if (utils::StartsWith(domain, "*.")) {
+    prefix_wild = true;
+    // *.domain.com -> .domain.com
+    domain = domain.substr(1);
+  }
+  if (utils::EndsWith(domain, ".*")) {
+    suffix_wild = true;
+    // domain.* -> domain.
+    domain = domain.substr(0, domain.length() - 1);
+  }
+
+  if (!prefix_wild && !suffix_wild) {
+    // domain.com : exactly matched
+    Insert(&domain_suffixes_, SplitReversedLabels(domain))->exact = true;
+  } else if (prefix_wild && !suffix_wild) {
+    // *.domain.com : "domain.com" or ends with ".domain.com"
+    Node* node = Insert(&domain_suffixes_,
+                        SplitReversedLabels(domain.substr(1)));
+    node->exact = true;
+    node->followed = true;
+  } else if (!prefix_wild && suffix_wild) {
+    // www.sample.* : starts with "www.sample."
+    domain.resize(domain.length() - 1);
+    Insert(&domain_prefixes_, SplitLabels(domain))->followed = true;
+  } else if (domain.length() < 2) {
+    // *.* : starts with ""
+    allow_all_ = true;
+  } else {
+    // *.sample.* : starts with "sample." or has ".sample."
+    domain = domain.substr(1, domain.length() - 2);
+    Insert(&domain_prefixes_, SplitLabels(domain))->anywhere = true;
+  }
+}
+
+bool AccessMatcher::Match(const URLView& url) const {
+  if (allow_all_)
+    return true;
+
+  const URLComponent& host = url.domain();
+  if (!domain_prefixes_.children.empty()) {
+    // from every label of the host
+    const char* end = host.data + host.length;
+    const char* label = host.data;
+    while (true) {
+      if (WalkForward(domain_prefixes_, host, label - host.data))
+        return true;
+      label = std::find(label, end, '.');
+      if (label == end)
+        break;
+      ++label;
+    }
+  }
+
+  if (WalkBackward(domain_suffixes_, host))
+    return true;
+  std::string scheme;
+  url.AppendScheme(&scheme);
+  auto origin = origins_.find(std::make_pair(scheme, url.port()));
+  return origin != origins_.end() && WalkBackward(origin->second, host);
+}
+
+// static
+AccessMatcher::Node* AccessMatcher::Insert(
+    Node* root, const std::vector<std::string>& labels) {
+  Node* node = root;
+  for (auto& label : labels) {
+    auto child =
+        node->children.find(URLComponent(label.data(), label.length()));
+    if (child == node->children.end()) {
+      Node* new_node = new Node;
+      new_node->label = label;
+      // The key points into the label the child owns.
+      URLComponent key(new_node->label.data(), new_node->label.length());
+      child = node->children.insert(
+          std::make_pair(key, std::unique_ptr<Node>(new_node))).first;
+    }
+    node = child->second.get();
+  }
+  return node;
+}
+
+// static
+bool AccessMatcher::WalkForward(const Node& root, const URLComponent& host,
+                                size_t begin) {
+  const char* label = host.data + begin;
+  const char* end = host.data + host.length;
+  const Node* node = &root;
+  while (true) {
+    const char* dot = std::find(label, end, '.');
+    auto child = node->children.find(URLComponent(label, dot - label));
+    if (child == node->children.end())
+      return false;
+    node = child->second.get();
+    if (dot == end)
+      return begin == 0 && node->exact;
+    if (node->anywhere || (node->followed && begin == 0))
+      return true;
+    label = dot + 1;
+  }
+}
+
+// static
+bool AccessMatcher::WalkBackward(const Node& root, const URLComponent& host) {
+  const char* label_end = host.data + host.length;
+  const Node* node = &root;
+  while (true) {
+    const char* label = label_end;
+    while (label != host.data && label[-1] != '.')
+      --label;
+    auto child = node->children.find(URLComponent(label, label_end - label));
+    if (child == node->children.end())
+      return false;
+    node = child->second.get();
+    if (label == host.data)
+      return node->exact;
+    if (node->anywhere || node->followed)
+      return true;
+    label_end = label - 1;
+  }
+}
+
+}  // namespace common
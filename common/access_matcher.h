@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_ACCESS_MATCHER_H_
+#define XWALK_COMMON_ACCESS_MATCHER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/url_view.h"
+
+namespace common {
+
+// Access rules of a widget, compiled into tries of domain labels so that a
+// url is matched in time proportional to its host name rather than to the
+// number of rules.
+class AccessMatcher {
+ public:
+  AccessMatcher();
+  ~AccessMatcher();
+
+  // <access origin="..." subdomains="..."/> of the WARP model. The scheme
+  // and the port of a url have to be equal to those of |origin|.
+  void AddWarpRule(const std::string& origin, bool subdomains);
+
+  // <tizen:allow-navigation> entry: "domain", "*.domain", "domain.*",
+  // "*.domain.*" or "*". Only the host of a url is compared.
+  void AddNavigationRule(const std::string& pattern);
+
+  bool Match(const URLView& url) const;
+
+ private:
+  // Labels are compared by their bytes, so that a url is matched on
+  // slices of its host without copying them.
+  struct LabelHash {
+    size_t operator()(const URLComponent& label) const;
+  };
+  struct LabelEqual {
+    bool operator()(const URLComponent& a, const URLComponent& b) const;
+  };
+
+  struct Node {
+    Node();
+
+    // The last label on the path to this node, the key in its parent.
+    std::string label;
+    // The labels on the path to this node are the whole host.
+    bool exact;
+    // ... are followed by at least one more label, and start the host.
+    bool followed;
+    // ... are followed by at least one more label, anywhere in the host.
+    bool anywhere;
+    std::unordered_map<URLComponent, std::unique_ptr<Node>, LabelHash,
+                       LabelEqual> children;
+  };
+
+  static Node* Insert(Node* root, const std::vector<std::string>& labels);
+  // Walks the labels of |host| from the one at |begin| to the last.
+  static bool WalkForward(const Node& root, const URLComponent& host,
+                          size_t begin);
+  // Walks the labels of |host| from the last to the first.
+  static bool WalkBackward(const Node& root, const URLComponent& host);
+
+  bool allow_all_;
+  // Reversed labels of <access> origins, by scheme and port.
+  std::map<std::pair<std::string, int>, Node> origins_;
+  // Reversed labels of allow-navigation domains and "*.domain" patterns.
+  Node domain_suffixes_;
+  // Labels of allow-navigation "domain.*" and "*.domain.*" patterns.
+  Node domain_prefixes_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_ACCESS_MATCHER_H_
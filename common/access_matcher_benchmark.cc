@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Compares the compiled AccessMatcher with a linear scan of the rules, the
+// way ResourceManager matched them before, on synthetic WARP and
+// allow-navigation rule sets.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/access_matcher.h"
+#include "common/benchmark_utils.h"
+#include "common/picojson.h"
+#include "common/string_utils.h"
+#include "common/url.h"
+#include "common/url_view.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+namespace utils = common::utils;
+
+const char kDefaultRules[] = "10,100,500,1000";
+const int kDefaultUrls = 1000;
+const int kDefaultIterations = 10;
+
+struct RuleSet {
+  std::map<std::string, bool> access;
+  std::vector<std::string> navigation;
+  std::vector<std::string> urls;
+};
+
+std::string Domain(int index) {
+  std::ostringstream domain;
+  domain << "site" << index << ".example" << index % 7 << ".com";
+  return domain.str();
+}
+
+// Rules cover every form the manifest allows, urls are a mix of exact,
+// subdomain, wildcard and missing hosts.
+RuleSet MakeRuleSet(int rules, int urls) {
+  RuleSet set;
+  for (int i = 0; i < rules; ++i) {
+    std::string domain = Domain(i);
+    switch (i % 4) {
+      case 0:
+        set.access["http://" + domain] = true;
+        set.navigation.push_back(domain);
+        break;
+      case 1:
+        set.access["https://" + domain] = false;
+        set.navigation.push_back("*." + domain);
+        break;
+      case 2:
+        set.access["https://" + domain + ":8443"] = true;
+        set.navigation.push_back(domain + ".*");
+        break;
+      default:
+        set.access["http://" + domain + ":8080"] = false;
+        set.navigation.push_back("*." + domain + ".*");
+        break;
+    }
+  }
+
+  const char* schemes[] = {"http://", "https://"};
+  const char* ports[] = {"", ":8080", ":8443"};
+  const char* prefixes[] = {"", "www.", "a.b."};
+  const char* suffixes[] = {"", ".net"};
+  for (int i = 0; i < urls; ++i) {
+    // One in four hosts is not in the rules at all.
+    std::string domain = Domain(i % 4 == 3 ? rules + i : i % rules);
+    set.urls.push_back(std::string(schemes[i % 2]) + prefixes[i % 3] +
+                       domain + suffixes[i / 3 % 2] + ports[i % 3] +
+                       "/index.html");
+  }
+  return set;
+}
+
+// The rule scans ResourceManager did before AccessMatcher.
+bool LinearWarp(const std::map<std::string, bool>& access_map,
+                const common::URL& url_info) {
+  for (auto& allow : access_map) {
+    if (allow.first == "*") {
+      return true;
+    } else if (allow.first.empty()) {
+      continue;
+    }
+    common::URL allow_url(allow.first);
+    if (allow_url.scheme() != url_info.scheme() ||
+        allow_url.port() != url_info.port()) {
+      continue;
+    }
+    if (allow_url.domain() == url_info.domain()) {
+      return true;
+    } else if (allow.second &&
+               utils::EndsWith(url_info.domain(), "." + allow_url.domain())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LinearNavigation(const std::vector<std::string>& allowed_domains,
+                      const common::URL& url_info) {
+  const std::string domain = url_info.domain();
+  for (auto& allow_domain : allowed_domains) {
+    std::string a_domain = common::URL(allow_domain).domain();
+    if (a_domain == "*")
+      return true;
+    bool prefix_wild = false;
+    bool suffix_wild = false;
+    if (utils::StartsWith(a_domain, "*.")) {
+      prefix_wild = true;
+      a_domain = a_domain.substr(1);
+    }
+    if (utils::EndsWith(a_domain, ".*")) {
+      suffix_wild = true;
+      a_domain = a_domain.substr(0, a_domain.length() - 1);
+    }
+    if (!prefix_wild && !suffix_wild) {
+      if (domain == a_domain)
+        return true;
+    } else if (prefix_wild && !suffix_wild) {
+      if (domain == a_domain.substr(1) || utils::EndsWith(domain, a_domain))
+        return true;
+    } else if (!prefix_wild && suffix_wild) {
+      if (utils::StartsWith(domain, a_domain))
+        return true;
+    } else if (utils::StartsWith(domain, a_domain.substr(1)) ||
+               std::string::npos != domain.find(a_domain)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PrintResult(const std::string& matcher, const std::string& model,
+                 int rules, size_t matches, size_t allowed, double seconds) {
+  picojson::object json;
+  json["matcher"] = picojson::value(matcher);
+  json["model"] = picojson::value(model);
+  json["rules"] = picojson::value(static_cast<double>(rules));
+  json["matches"] = picojson::value(static_cast<double>(matches));
+  json["allowed"] = picojson::value(static_cast<double>(allowed));
+  json["seconds"] = picojson::value(seconds);
+  json["ns_per_match"] = picojson::value(
+      benchmark::PerItem(seconds, matches, 1e9));
+  benchmark::PrintResult(json);
+}
+
+// Returns the number of urls the two matchers disagree on.
+int Run(const std::string& model, int rules, int urls, int iterations) {
+  RuleSet set = MakeRuleSet(rules, urls);
+  bool warp = model == "warp";
+
+  double start = benchmark::Now();
+  common::AccessMatcher matcher;
+  if (warp) {
+    for (auto& allow : set.access)
+      matcher.AddWarpRule(allow.first, allow.second);
+  } else {
+    for (auto& allow_domain : set.navigation)
+      matcher.AddNavigationRule(allow_domain);
+  }
+  double compile_seconds = benchmark::Now() - start;
+
+  std::vector<common::URL*> parsed;
+  std::vector<common::URLView> views;
+  for (auto& url : set.urls) {
+    parsed.push_back(new common::URL(url));
+    views.push_back(common::URLView(url));
+  }
+
+  std::vector<bool> linear_result(parsed.size());
+  size_t allowed = 0;
+  start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < parsed.size(); ++j) {
+      linear_result[j] = warp ? LinearWarp(set.access, *parsed[j]) :
+                                LinearNavigation(set.navigation, *parsed[j]);
+      if (i == 0 && linear_result[j])
+        ++allowed;
+    }
+  }
+  PrintResult("linear", model, rules, parsed.size() * iterations, allowed,
+              benchmark::Now() - start);
+
+  int mismatches = 0;
+  allowed = 0;
+  start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < parsed.size(); ++j) {
+      bool result = matcher.Match(views[j]);
+      if (i > 0)
+        continue;
+      if (result)
+        ++allowed;
+      if (result != linear_result[j]) {
+        fprintf(stderr, "Mismatch for %s : %d\n", set.urls[j].c_str(),
+                result);
+        ++mismatches;
+      }
+    }
+  }
+  PrintResult("compiled", model, rules, parsed.size() * iterations, allowed,
+              benchmark::Now() - start + compile_seconds);
+
+  for (auto url : parsed)
+    delete url;
+  return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  std::vector<int> rule_counts = options.IntList("rules", kDefaultRules);
+  int urls = options.Int("urls", kDefaultUrls);
+  int iterations = options.Int("iterations", kDefaultIterations);
+  if (rule_counts.empty())
+    return options.Usage();
+
+  int mismatches = 0;
+  for (int rule_count : rule_counts) {
+    mismatches += Run("warp", rule_count, urls, iterations);
+    mismatches += Run("navigation", rule_count, urls, iterations);
+  }
+  return benchmark::ExitStatus(mismatches);
+}
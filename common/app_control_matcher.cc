@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/app_control_matcher.h"
+
+#include <string.h>
+
+#include "common/string_utils.h"
+
+namespace common {
+
+namespace {
+
+// Keeps the smaller of two entry numbers, -1 being none.
+int First(int a, int b) {
+  if (a < 0)
+    return b;
+  if (b < 0)
+    return a;
+  return a < b ? a : b;
+}
+
+// Length of the scheme of |uri|, the whole uri if it has no ':'.
+size_t SchemeLength(const std::string& uri) {
+  size_t pos = uri.find(':');
+  return pos != std::string::npos ? pos : uri.length();
+}
+
+}  // namespace
+
+template <typename T>
+T* AppControlMatcher::PieceMap<T>::Insert(const std::string& key) {
+  size_t hash = Hash(key.data(), key.length());
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.first == key)
+      return &it->second.second;
+  }
+  auto it = entries_.insert(std::make_pair(hash, std::make_pair(key, T())));
+  return &it->second.second;
+}
+
+template <typename T>
+const T* AppControlMatcher::PieceMap<T>::Find(const char* data,
+                                              size_t length) const {
+  auto range = entries_.equal_range(Hash(data, length));
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::string& key = it->second.first;
+    if (key.length() == length && memcmp(key.data(), data, length) == 0)
+      return &it->second.second;
+  }
+  return NULL;
+}
+
+// static
+template <typename T>
+size_t AppControlMatcher::PieceMap<T>::Hash(const char* data, size_t length) {
+  // FNV-1a
+  size_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+AppControlMatcher::UriIndex::UriIndex() : empty(-1) {
+}
+
+void AppControlMatcher::UriIndex::Add(const std::string& uri, int number) {
+  if (uri.empty()) {
+    empty = First(empty, number);
+    return;
+  }
+
+  // if has only scheme or scheme+star. ex) http, http://, http://*
+  size_t scheme_length = SchemeLength(uri);
+  if (scheme_length > 0 &&
+      (scheme_length == uri.length() || utils::EndsWith(uri, "://") ||
+       utils::EndsWith(uri, "://*"))) {
+    // entries are added in order, so the one already there comes first
+    if (schemes.Find(uri.data(), scheme_length) == NULL)
+      *schemes.Insert(uri.substr(0, scheme_length)) = number;
+    return;
+  }
+
+  if (utils::EndsWith(uri, "*")) {
+    prefixes.push_back(
+        std::make_pair(uri.substr(0, uri.length() - 1), number));
+  } else {
+    if (exact.Find(uri.data(), uri.length()) == NULL)
+      *exact.Insert(uri) = number;
+  }
+}
+
+int AppControlMatcher::UriIndex::Match(const std::string& uri) const {
+  if (uri.empty())
+    return empty;
+
+  int result = -1;
+  const int* found = exact.Find(uri.data(), uri.length());
+  if (found != NULL)
+    result = *found;
+  found = schemes.Find(uri.data(), SchemeLength(uri));
+  if (found != NULL)
+    result = First(result, *found);
+  for (auto& prefix : prefixes) {
+    if (result >= 0 && prefix.second > result)
+      break;
+    if (uri.compare(0, prefix.first.length(), prefix.first) == 0) {
+      result = First(result, prefix.second);
+      break;
+    }
+  }
+  return result;
+}
+
+AppControlMatcher::AppControlMatcher() : size_(0) {
+}
+
+AppControlMatcher::~AppControlMatcher() {
+}
+
+void AppControlMatcher::Add(const std::string& operation,
+                            const std::string& mime,
+                            const std::string& uri) {
+  int number = size_++;
+  OperationIndex* index = operations_.Insert(operation);
+
+  // suppose that these mimetypes are valid expressions ('type'/'sub-type')
+  size_t separator = mime.find('/');
+  if (mime == "*" || mime == "*/*") {
+    index->any_mime.Add(uri, number);
+  } else if (mime.empty()) {
+    index->empty_mime.Add(uri, number);
+  } else if (separator == std::string::npos) {
+    // never matches
+  } else if (mime.compare(separator, std::string::npos, "/*") == 0) {
+    index->mime_types.Insert(mime.substr(0, separator))->Add(uri, number);
+  } else {
+    index->mimes.Insert(mime)->Add(uri, number);
+  }
+}
+
+int AppControlMatcher::Match(const std::string& operation,
+                             const std::string& mime,
+                             const std::string& uri) const {
+  const OperationIndex* index =
+      operations_.Find(operation.data(), operation.length());
+  if (index == NULL)
+    return -1;
+
+  int result = index->any_mime.Match(uri);
+  if (mime.empty())
+    return First(result, index->empty_mime.Match(uri));
+
+  const UriIndex* mime_index = index->mimes.Find(mime.data(), mime.length());
+  if (mime_index != NULL)
+    result = First(result, mime_index->Match(uri));
+  size_t separator = mime.find('/');
+  if (separator != std::string::npos) {
+    mime_index = index->mime_types.Find(mime.data(), separator);
+    if (mime_index != NULL)
+      result = First(result, mime_index->Match(uri));
+  }
+  return result;
+}
+
+}  // namespace common
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_APP_CONTROL_MATCHER_H_
+#define XWALK_COMMON_APP_CONTROL_MATCHER_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace common {
+
+// App-control entries of a widget, indexed by operation, then by MIME type
+// and then by URI, so that a request is matched without scanning or
+// copying strings.
+class AppControlMatcher {
+ public:
+  AppControlMatcher();
+  ~AppControlMatcher();
+
+  // Entries are numbered in the order they are added.
+  //  mime : "", "*", "*/*", "type/*" or "type/sub-type"
+  //  uri : "", "scheme", "scheme://", "scheme://*", "prefix*" or a uri
+  void Add(const std::string& operation, const std::string& mime,
+           const std::string& uri);
+
+  // Returns the number of the first entry matching the request, or -1.
+  int Match(const std::string& operation, const std::string& mime,
+            const std::string& uri) const;
+
+ private:
+  // Strings mapped to values, found by a part of another string.
+  template <typename T>
+  class PieceMap {
+   public:
+    T* Insert(const std::string& key);
+    const T* Find(const char* data, size_t length) const;
+
+   private:
+    static size_t Hash(const char* data, size_t length);
+
+    std::unordered_multimap<size_t, std::pair<std::string, T> > entries_;
+  };
+
+  // First entries of each kind of uri for one operation and MIME type.
+  struct UriIndex {
+    UriIndex();
+    void Add(const std::string& uri, int number);
+    int Match(const std::string& uri) const;
+
+    int empty;
+    PieceMap<int> exact;
+    PieceMap<int> schemes;
+    // in the order they were added
+    std::vector<std::pair<std::string, int> > prefixes;
+  };
+
+  struct OperationIndex {
+    UriIndex any_mime;
+    UriIndex empty_mime;
+    PieceMap<UriIndex> mimes;
+    // by "type" of "type/*"
+    PieceMap<UriIndex> mime_types;
+  };
+
+  PieceMap<OperationIndex> operations_;
+  int size_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_APP_CONTROL_MATCHER_H_
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Compares the indexed AppControlMatcher with a scan of the app-control
+// list, the way ResourceManager matched it before, on synthetic manifests.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/app_control_matcher.h"
+#include "common/benchmark_utils.h"
+#include "common/file_utils.h"
+#include "common/picojson.h"
+#include "common/string_utils.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+namespace utils = common::utils;
+
+const char kDefaultEntries[] = "10,100,500,1000";
+const int kDefaultRequests = 1000;
+const int kDefaultIterations = 10;
+
+struct AppControl {
+  std::string operation;
+  std::string mime;
+  std::string uri;
+};
+
+std::string Numbered(const std::string& prefix, int number) {
+  std::ostringstream str;
+  str << prefix << number;
+  return str.str();
+}
+
+// Entries use every form of MIME type and URI the manifest allows, requests
+// mix hits and misses of each.
+std::vector<AppControl> MakeEntries(int count) {
+  const char* mimes[] = {"", "*", "*/*", "image/*", "image/png", "text/html"};
+  std::vector<AppControl> entries;
+  for (int i = 0; i < count; ++i) {
+    AppControl entry;
+    entry.operation = Numbered("http://tizen.org/appcontrol/operation/op",
+                               i % 13);
+    entry.mime = i % 5 == 4 ? Numbered("application/x-type", i) :
+                              mimes[i % 6];
+    switch (i % 7) {
+      case 0: entry.uri = ""; break;
+      case 1: entry.uri = Numbered("scheme", i); break;
+      case 2: entry.uri = Numbered("scheme", i) + "://"; break;
+      case 3: entry.uri = Numbered("scheme", i) + "://*"; break;
+      case 4: entry.uri = Numbered("http://host", i) + "/*"; break;
+      default: entry.uri = Numbered("http://host", i) + "/index.html"; break;
+    }
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+std::vector<AppControl> MakeRequests(int entries, int count) {
+  const char* mimes[] = {"", "image/png", "image/jpeg", "text/html",
+                         "text/plain"};
+  std::vector<AppControl> requests;
+  for (int i = 0; i < count; ++i) {
+    int target = (i * 7919) % (entries + entries / 4 + 1);
+    AppControl request;
+    request.operation = Numbered("http://tizen.org/appcontrol/operation/op",
+                                 i % 14);
+    request.mime = i % 5 == 4 ? Numbered("application/x-type", target) :
+                                mimes[i % 5];
+    switch (i % 4) {
+      case 0: request.uri = ""; break;
+      case 1: request.uri = Numbered("scheme", target) + "://path"; break;
+      case 2: request.uri = Numbered("http://host", target) + "/a/b"; break;
+      default:
+        request.uri = Numbered("http://host", target) + "/index.html";
+        break;
+    }
+    requests.push_back(request);
+  }
+  return requests;
+}
+
+// The comparisons ResourceManager made before AppControlMatcher.
+bool CompareMime(const std::string& info_mime,
+                 const std::string& request_mime) {
+  if (info_mime == "*" || info_mime == "*/*")
+    return true;
+  if (request_mime.empty())
+    return info_mime.empty();
+  std::string info_type;
+  std::string info_sub;
+  std::string request_type;
+  std::string request_sub;
+  if (!(utils::SplitString(info_mime, &info_type, &info_sub, '/') &&
+        utils::SplitString(request_mime, &request_type, &request_sub, '/')))
+    return false;
+  return info_type == request_type &&
+         (info_sub == "*" || info_sub == request_sub);
+}
+
+bool CompareUri(const std::string& info_uri,
+                const std::string& request_uri) {
+  if (request_uri.empty())
+    return info_uri.empty();
+  std::string info_scheme = utils::SchemeName(info_uri);
+  if (!info_scheme.empty() &&
+      (info_uri == info_scheme || utils::EndsWith(info_uri, "://")
+        || utils::EndsWith(info_uri, "://*"))) {
+    return utils::SchemeName(request_uri) == info_scheme;
+  }
+  if (utils::EndsWith(info_uri, "*")) {
+    return utils::StartsWith(request_uri,
+                             info_uri.substr(0, info_uri.length() - 1));
+  } else {
+    return request_uri == info_uri;
+  }
+}
+
+int LinearMatch(const std::vector<AppControl>& entries,
+                const AppControl& request) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i].operation == request.operation &&
+        CompareMime(entries[i].mime, request.mime) &&
+        CompareUri(entries[i].uri, request.uri))
+      return i;
+  }
+  return -1;
+}
+
+void PrintResult(const std::string& matcher, int entries, size_t matches,
+                 size_t matched, double seconds) {
+  picojson::object json;
+  json["matcher"] = picojson::value(matcher);
+  json["entries"] = picojson::value(static_cast<double>(entries));
+  json["matches"] = picojson::value(static_cast<double>(matches));
+  json["matched"] = picojson::value(static_cast<double>(matched));
+  json["seconds"] = picojson::value(seconds);
+  json["ns_per_match"] = picojson::value(
+      benchmark::PerItem(seconds, matches, 1e9));
+  benchmark::PrintResult(json);
+}
+
+// Returns the number of requests the two matchers disagree on.
+int Run(int entry_count, int request_count, int iterations) {
+  std::vector<AppControl> entries = MakeEntries(entry_count);
+  std::vector<AppControl> requests = MakeRequests(entry_count, request_count);
+
+  std::vector<int> linear_result(requests.size());
+  size_t matched = 0;
+  double start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < requests.size(); ++j) {
+      linear_result[j] = LinearMatch(entries, requests[j]);
+      if (i == 0 && linear_result[j] >= 0)
+        ++matched;
+    }
+  }
+  PrintResult("linear", entry_count, requests.size() * iterations, matched,
+              benchmark::Now() - start);
+
+  start = benchmark::Now();
+  common::AppControlMatcher matcher;
+  for (auto& entry : entries)
+    matcher.Add(entry.operation, entry.mime, entry.uri);
+  int mismatches = 0;
+  matched = 0;
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < requests.size(); ++j) {
+      const AppControl& request = requests[j];
+      int result = matcher.Match(request.operation, request.mime,
+                                 request.uri);
+      if (i > 0)
+        continue;
+      if (result >= 0)
+        ++matched;
+      if (result != linear_result[j]) {
+        fprintf(stderr, "Mismatch for %s %s %s : %d, expected %d\n",
+                request.operation.c_str(), request.mime.c_str(),
+                request.uri.c_str(), result, linear_result[j]);
+        ++mismatches;
+      }
+    }
+  }
+  PrintResult("indexed", entry_count, requests.size() * iterations, matched,
+              benchmark::Now() - start);
+  return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  std::vector<int> entry_counts = options.IntList("entries", kDefaultEntries);
+  int requests = options.Int("requests", kDefaultRequests);
+  int iterations = options.Int("iterations", kDefaultIterations);
+  if (entry_counts.empty())
+    return options.Usage();
+
+  int mismatches = 0;
+  for (int entry_count : entry_counts)
+    mismatches += Run(entry_count, requests, iterations);
+  return benchmark::ExitStatus(mismatches);
+}
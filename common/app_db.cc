@@ -16,110 +16,101 @@
 
 #include "common/app_db.h"
 
+#include <glib.h>
+
 //  #define USE_APP_PREFERENCE;
-#ifdef USE_APP_PREFERENCE
-#include <app_preference.h>
-#else
+//  #define USE_APP_DB_LOG;
+#ifndef USE_APP_PREFERENCE
 #include <app.h>
 #include <sqlite3.h>
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <set>
 
 #include "common/logger.h"
-#include "common/string_utils.h"
-#ifndef USE_APP_PREFERENCE
+#ifdef USE_APP_PREFERENCE
+#include "common/app_db_preference.h"
+#else
+#include "common/app_db_log.h"
 #include "common/app_db_sqlite.h"
 #endif
 
 namespace common {
 
 namespace {
-#ifdef USE_APP_PREFERENCE
-const char* kSectionPrefix = "_SECT_";
-const char* kSectionSuffix = "_SECT_";
-#else
+#ifndef USE_APP_PREFERENCE
 const char* kCreateDbQuery = "CREATE TABLE IF NOT EXISTS appdb ("
                              "section TEXT, "
                              "key TEXT, "
                              "value TEXT,"
                              "PRIMARY KEY(section, key));";
-#endif
-}  // namespace
-
-#ifdef USE_APP_PREFERENCE
-
-class PreferenceAppDB : public AppDB {
- public:
-  PreferenceAppDB();
-  virtual bool HasKey(const std::string& section,
-                      const std::string& key) const;
-  virtual std::string Get(const std::string& section,
-                          const std::string& key) const;
-  virtual void Set(const std::string& section,
-                   const std::string& key,
-                   const std::string& value);
-  virtual void GetKeys(const std::string& section,
-                       std::list<std::string>* keys) const;
-  virtual void Remove(const std::string& section,
-                      const std::string& key);
+const char* kConfigureDbQuery = "PRAGMA journal_mode = WAL;"
+                                "PRAGMA synchronous = NORMAL;"
+                                "PRAGMA wal_autocheckpoint = 256;";
+
+// Indexed by SqliteDB::StatementId.
+const char* kStatementQueries[] = {
+  "replace into appdb (section, key, value) values (?, ?, ?)",
+  "delete from appdb where section = ? and key = ?",
+  "select key, value from appdb where section = ?",
+  "pragma data_version",
+  "begin immediate",
+  "commit",
+  "rollback",
 };
 
-PreferenceAppDB::PreferenceAppDB() {
-}
+// How often sections with change listeners are checked for commits made
+// by other processes.
+const guint kChangePollIntervalMs = 500;
 
-bool PreferenceAppDB::HasKey(const std::string& section,
-                             const std::string& key) const {
-  bool existed = false;
-  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
-  return preference_is_existing(combined_key.c_str(), &existed) == 0 && existed;
-}
+// A flush that failed is tried again after this delay.
+const guint kFlushRetryDelayMs = 1000;
 
-std::string PreferenceAppDB::Get(const std::string& section,
-                                 const std::string& key) const {
-  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
-  char* value;
-  if (preference_get_string(combined_key.c_str(), &value) == 0) {
-    std::unique_ptr<char, decltype(std::free)*> ptr {value, std::free};
-    return std::string(value);
-  }
-  return std::string();
-}
+// Each retry sleeps twice as long as the previous one, up to
+// kBusyMaxSleepUs, until kBusyTimeoutUs were spent waiting in all. That is
+// as long as the fixed steps used before waited, but short locks are
+// retried sooner.
+const int kBusyMaxSleepUs = 100 * 1000;
+const int kBusyTimeoutUs = 1500 * 1000;
 
-void PreferenceAppDB::Set(const std::string& section,
-                          const std::string& key,
-                          const std::string& value) {
-  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
-  preference_set_string(combined_key.c_str(), value.c_str());
-}
+// Returns a cached statement to its initial state once a call is done with
+// it, so that the next call can bind new arguments.
+class ScopedStatementReset {
+ public:
+  explicit ScopedStatementReset(sqlite3_stmt* stmt) : stmt_(stmt) {}
+  ~ScopedStatementReset() {
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+  }
 
-void PreferenceAppDB::GetKeys(const std::string& section,
-                              std::list<std::string>* keys) const {
-  auto callback = [](const char* key, void *user_data) {
-    auto list = static_cast<std::list<std::string>*>(user_data);
-    if (utils::StartsWith(key, list->front())) {
-      list->push_back(key+list->front().size());
-    }
-    return true;
-  };
-  std::string key_prefix = kSectionPrefix + section + kSectionSuffix;
-  keys->push_front(key_prefix);
-  preference_foreach_item(callback, keys);
-  keys->pop_front();
-}
+ private:
+  sqlite3_stmt* stmt_;
+};
 
-void PreferenceAppDB::Remove(const std::string& section,
-                             const std::string& key) {
-  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
-  preference_remove(combined_key.c_str());
+// How long the busy handler sleeps before the |count|th retry.
+int BusySleepUs(int count) {
+  // 1000 << 7 is over the limit already, larger shifts would overflow
+  return count < 7 ? std::min(1000 << count, kBusyMaxSleepUs)
+                   : kBusyMaxSleepUs;
 }
+#endif
+}  // namespace
 
-#else  // end of USE_APP_PREFERENCE
+#ifndef USE_APP_PREFERENCE
 
 SqliteDB::SqliteDB(const std::string& app_data_path)
     : app_data_path_(app_data_path),
-      sqldb_(NULL) {
+      sqldb_(NULL),
+      flush_source_id_(0),
+      transaction_depth_(0),
+      data_version_(-1),
+      polled_version_(-1),
+      poll_source_id_(0) {
+  for (int i = 0; i < kStatementCount; ++i)
+    statements_[i] = NULL;
   if (app_data_path_.empty()) {
     std::unique_ptr<char, decltype(std::free)*>
     path {app_get_data_path(), std::free};
@@ -130,6 +121,16 @@ SqliteDB::SqliteDB(const std::string& app_data_path)
 }
 
 SqliteDB::~SqliteDB() {
+  // A failed Flush() schedules a retry, which is removed right after.
+  Flush();
+  if (flush_source_id_)
+    g_source_remove(flush_source_id_);
+  if (poll_source_id_)
+    g_source_remove(poll_source_id_);
+  for (int i = 0; i < kStatementCount; ++i) {
+    if (statements_[i] != NULL)
+      sqlite3_finalize(statements_[i]);
+  }
   if (sqldb_ != NULL) {
     sqlite3_close(sqldb_);
     sqldb_ = NULL;
@@ -149,9 +150,12 @@ void SqliteDB::Initialize() {
     return;
   }
   sqlite3_busy_handler(sqldb_, [](void *, int count) {
-    if (count < 5) {
-      LOGGER(ERROR) << "App db was busy, Wait the lock count(" << count << ")";
-      usleep(100000*(count+1));
+    int waited_us = 0;
+    for (int i = 0; i < count; ++i)
+      waited_us += BusySleepUs(i);
+    if (waited_us < kBusyTimeoutUs) {
+      LOGGER(WARN) << "App db was busy, Wait the lock count(" << count << ")";
+      usleep(BusySleepUs(count));
       return 1;
     } else {
       LOGGER(ERROR) << "App db was busy, Fail to access";
@@ -159,7 +163,18 @@ void SqliteDB::Initialize() {
     }
   }, NULL);
 
+  // The runtime, the extension process and the renderer all use this
+  // database. With WAL, readers don't wait for a writer, and a commit only
+  // needs the log to be synced at checkpoints.
   char *errmsg = NULL;
+  ret = sqlite3_exec(sqldb_, kConfigureDbQuery, NULL, NULL, &errmsg);
+  if (ret != SQLITE_OK) {
+    LOGGER(WARN) << "Fail to configure appdb : " << (errmsg ? errmsg : "");
+    if (errmsg)
+      sqlite3_free(errmsg);
+    errmsg = NULL;
+  }
+
   ret = sqlite3_exec(sqldb_, kCreateDbQuery, NULL, NULL, &errmsg);
   if (ret != SQLITE_OK) {
     LOGGER(ERROR) << "Error to create appdb : " << (errmsg ? errmsg : "");
@@ -168,208 +183,450 @@ void SqliteDB::Initialize() {
   }
 }
 
-bool SqliteDB::HasKey(const std::string& section,
-                      const std::string& key) const {
-  char *buffer = NULL;
-  sqlite3_stmt *stmt = NULL;
-  bool result = false;
-
-  int ret = 0;
-  buffer = sqlite3_mprintf(
-      "select count(*) from appdb where section = %Q and key = %Q",
-      section.c_str(),
-      key.c_str());
-  if (buffer == NULL) {
-    LOGGER(ERROR) << "error to make query";
-    return false;
-  }
-
-  std::unique_ptr<char, decltype(sqlite3_free)*>
-      scoped_data {buffer, sqlite3_free};
+sqlite3_stmt* SqliteDB::GetStatement(StatementId id) const {
+  if (sqldb_ == NULL)
+    return NULL;
+  if (statements_[id] != NULL)
+    return statements_[id];
 
-  ret = sqlite3_prepare(sqldb_, buffer, strlen(buffer), &stmt, NULL);
+  sqlite3_stmt* stmt = NULL;
+  int ret = sqlite3_prepare_v2(sqldb_, kStatementQueries[id], -1, &stmt, NULL);
   if (ret != SQLITE_OK) {
     LOGGER(ERROR) << "Fail to prepare query : " << sqlite3_errmsg(sqldb_);
-    return false;
+    return NULL;
   }
+  statements_[id] = stmt;
+  return stmt;
+}
 
-  ret = sqlite3_step(stmt);
-  if (ret == SQLITE_ROW) {
-    int value = sqlite3_column_int(stmt, 0);
-    result = value > 0;
+bool SqliteDB::BindText(sqlite3_stmt* stmt, int index,
+                        const std::string& text) const {
+  int ret = sqlite3_bind_text(stmt, index, text.c_str(), text.length(),
+                              SQLITE_STATIC);
+  if (ret != SQLITE_OK) {
+    LOGGER(ERROR) << "Fail to prepare query bind argument : "
+                  << sqlite3_errmsg(sqldb_);
+    return false;
   }
+  return true;
+}
 
-  sqlite3_finalize(stmt);
-  return result;
+int SqliteDB::DataVersion() const {
+  ValidateCache();
+  return data_version_;
 }
 
-std::string SqliteDB::Get(const std::string& section,
-                          const std::string& key) const {
-  char *buffer = NULL;
-  sqlite3_stmt *stmt = NULL;
-  std::string result;
+void SqliteDB::ValidateCache() const {
+  sqlite3_stmt* stmt = GetStatement(kDataVersionStatement);
+  if (stmt == NULL)
+    return;
+  ScopedStatementReset scoped_reset(stmt);
 
-  int ret = 0;
-  buffer = sqlite3_mprintf(
-      "select value from appdb where section = %Q and key = %Q",
-      section.c_str(),
-      key.c_str());
-  if (buffer == NULL) {
-    LOGGER(ERROR) << "error to make query";
-    return result;
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    return;
+  int version = sqlite3_column_int(stmt, 0);
+  if (version != data_version_) {
+    cache_.clear();
+    data_version_ = version;
   }
+}
 
-  std::unique_ptr<char, decltype(sqlite3_free)*>
-      scoped_data {buffer, sqlite3_free};
+const AppDB::ValueMap* SqliteDB::LoadSection(
+    const std::string& section) const {
+  ValidateCache();
+  auto cached = cache_.find(section);
+  if (cached != cache_.end())
+    return &cached->second;
 
-  ret = sqlite3_prepare(sqldb_, buffer, strlen(buffer), &stmt, NULL);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query : " << sqlite3_errmsg(sqldb_);
-    return result;
-  }
+  sqlite3_stmt* stmt = GetStatement(kGetAllStatement);
+  if (stmt == NULL)
+    return NULL;
+  ScopedStatementReset scoped_reset(stmt);
 
-  ret = sqlite3_step(stmt);
-  if (ret == SQLITE_ROW) {
-    result = std::string(
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+  if (!BindText(stmt, 1, section))
+    return NULL;
+
+  ValueMap values;
+  int ret = sqlite3_step(stmt);
+  while (ret == SQLITE_ROW) {
+    const char* key =
+        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    const char* value =
+        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+    if (key) {
+      values[std::string(key, sqlite3_column_bytes(stmt, 0))] =
+          value ? std::string(value, sqlite3_column_bytes(stmt, 1))
+                : std::string();
+    }
+    ret = sqlite3_step(stmt);
   }
+  if (ret != SQLITE_DONE) {
+    LOGGER(ERROR) << "Fail to read app db : " << sqlite3_errmsg(sqldb_);
+    return NULL;
+  }
+
+  ValueMap& cached_values = cache_[section];
+  cached_values.swap(values);
+  return &cached_values;
+}
+
+bool SqliteDB::HasKey(const std::string& section,
+                      const std::string& key) const {
+  auto pending = pending_.find(PendingKey(section, key));
+  if (pending != pending_.end())
+    return pending->second.first;
+
+  const ValueMap* values = LoadSection(section);
+  return values != NULL && values->find(key) != values->end();
+}
 
-  sqlite3_finalize(stmt);
+std::string SqliteDB::Get(const std::string& section,
+                          const std::string& key) const {
+  std::string result;
+  TryGet(section, key, &result);
   return result;
 }
 
+bool SqliteDB::TryGet(const std::string& section,
+                      const std::string& key,
+                      std::string* value) const {
+  auto pending = pending_.find(PendingKey(section, key));
+  if (pending != pending_.end()) {
+    if (pending->second.first)
+      *value = pending->second.second;
+    return pending->second.first;
+  }
+
+  const ValueMap* values = LoadSection(section);
+  if (values == NULL)
+    return false;
+  auto found = values->find(key);
+  if (found == values->end())
+    return false;
+  *value = found->second;
+  return true;
+}
+
 void SqliteDB::Set(const std::string& section,
                    const std::string& key,
                    const std::string& value) {
-  char *buffer = NULL;
-  sqlite3_stmt *stmt = NULL;
-
-  int ret = 0;
-  buffer = sqlite3_mprintf(
-      "replace into appdb (section, key, value) values (?, ?, ?);");
-  if (buffer == NULL) {
-    LOGGER(ERROR) << "error to make query";
-    return;
+  pending_[PendingKey(section, key)] = std::make_pair(true, value);
+  ScheduleFlush();
+  OnLocalChange(section);
+}
+
+void SqliteDB::SetMany(const std::string& section,
+                       const ValueMap& values) {
+  for (auto it = values.begin(); it != values.end(); ++it) {
+    pending_[PendingKey(section, it->first)] =
+        std::make_pair(true, it->second);
   }
+  ScheduleFlush();
+  OnLocalChange(section);
+}
 
-  std::unique_ptr<char, decltype(sqlite3_free)*>
-      scoped_data {buffer, sqlite3_free};
+void SqliteDB::Remove(const std::string& section,
+                      const std::string& key) {
+  pending_[PendingKey(section, key)] = std::make_pair(false, std::string());
+  ScheduleFlush();
+  OnLocalChange(section);
+}
 
-  ret = sqlite3_prepare(sqldb_, buffer, strlen(buffer), &stmt, NULL);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query : " << sqlite3_errmsg(sqldb_);
-    return;
+void SqliteDB::RemoveMany(const std::string& section,
+                          const std::list<std::string>& keys) {
+  for (auto it = keys.begin(); it != keys.end(); ++it) {
+    pending_[PendingKey(section, *it)] = std::make_pair(false, std::string());
   }
+  ScheduleFlush();
+  OnLocalChange(section);
+}
 
-  std::unique_ptr<sqlite3_stmt, decltype(sqlite3_finalize)*>
-      scoped_stmt {stmt, sqlite3_finalize};
+void SqliteDB::BeginTransaction() {
+  transaction_depth_++;
+}
 
-  ret = sqlite3_bind_text(stmt,
-                          1,
-                          section.c_str(),
-                          section.length(),
-                          SQLITE_STATIC);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query bind argument : "
-                  << sqlite3_errmsg(sqldb_);
-    return;
-  }
-  ret = sqlite3_bind_text(stmt,
-                          2,
-                          key.c_str(),
-                          key.length(),
-                          SQLITE_STATIC);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query bind argument : "
-                  << sqlite3_errmsg(sqldb_);
-    return;
-  }
-  ret = sqlite3_bind_text(stmt,
-                          3,
-                          value.c_str(),
-                          value.length(),
-                          SQLITE_STATIC);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query bind argument : "
-                  << sqlite3_errmsg(sqldb_);
-    return;
-  }
-  ret = sqlite3_step(stmt);
+void SqliteDB::EndTransaction() {
+  if (transaction_depth_ > 0 && --transaction_depth_ == 0)
+    Flush();
+}
+
+bool SqliteDB::ExecuteStatement(StatementId id) {
+  sqlite3_stmt* stmt = GetStatement(id);
+  if (stmt == NULL)
+    return false;
+  ScopedStatementReset scoped_reset(stmt);
+  return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+bool SqliteDB::WriteValue(const std::string& section,
+                          const std::string& key,
+                          const std::string& value) {
+  sqlite3_stmt* stmt = GetStatement(kSetStatement);
+  if (stmt == NULL)
+    return false;
+  ScopedStatementReset scoped_reset(stmt);
+
+  if (!BindText(stmt, 1, section) || !BindText(stmt, 2, key) ||
+      !BindText(stmt, 3, value))
+    return false;
+
+  int ret = sqlite3_step(stmt);
   if (ret != SQLITE_DONE) {
     LOGGER(ERROR) << "Fail to insert data : " << sqlite3_errmsg(sqldb_);
+    return false;
   }
+  return true;
 }
 
-void SqliteDB::Remove(const std::string& section,
-                      const std::string& key) {
-  char *buffer = NULL;
+bool SqliteDB::DeleteValue(const std::string& section,
+                           const std::string& key) {
+  sqlite3_stmt* stmt = GetStatement(kRemoveStatement);
+  if (stmt == NULL)
+    return false;
+  ScopedStatementReset scoped_reset(stmt);
+
+  if (!BindText(stmt, 1, section) || !BindText(stmt, 2, key))
+    return false;
+
+  int ret = sqlite3_step(stmt);
+  if (ret != SQLITE_DONE) {
+    LOGGER(ERROR) << "Error to delete value : " << sqlite3_errmsg(sqldb_);
+    return false;
+  }
+  return true;
+}
+
+void SqliteDB::ScheduleFlush() {
+  // A Transaction flushes when it ends.
+  if (flush_source_id_ || transaction_depth_ > 0)
+    return;
+  if (CanDeferWrites())
+    flush_source_id_ = g_idle_add(FlushCallback, this);
+  else
+    Flush();
+}
 
-  buffer = sqlite3_mprintf(
-      "delete from appdb where section = %Q and key = %Q",
-      section.c_str(),
-      key.c_str());
+void SqliteDB::ScheduleRetry() {
+  // The changes stay buffered. Without a main loop, the next change or
+  // Flush() tries again.
+  if (!flush_source_id_ && CanDeferWrites())
+    flush_source_id_ = g_timeout_add(kFlushRetryDelayMs, FlushCallback, this);
+}
+
+// static
+gboolean SqliteDB::FlushCallback(gpointer user_data) {
+  SqliteDB* self = static_cast<SqliteDB*>(user_data);
+  self->flush_source_id_ = 0;
+  self->Flush();
+  return FALSE;
+}
 
-  if (buffer == NULL) {
-    LOGGER(ERROR) << "error to make query";
+void SqliteDB::Flush() {
+  if (pending_.empty() || sqldb_ == NULL || transaction_depth_ > 0)
+    return;
+
+  if (!ExecuteStatement(kBeginStatement)) {
+    LOGGER(ERROR) << "Fail to begin transaction : " << sqlite3_errmsg(sqldb_);
+    ScheduleRetry();
     return;
   }
 
-  std::unique_ptr<char, decltype(sqlite3_free)*>
-      scoped_data {buffer, sqlite3_free};
+  bool success = true;
+  for (auto it = pending_.begin(); success && it != pending_.end(); ++it) {
+    const PendingKey& key = it->first;
+    if (it->second.first)
+      success = WriteValue(key.first, key.second, it->second.second);
+    else
+      success = DeleteValue(key.first, key.second);
+  }
 
-  char *errmsg = NULL;
-  int ret = sqlite3_exec(sqldb_, buffer, NULL, NULL, &errmsg);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Error to delete value : " << (errmsg ? errmsg : "");
-    if (errmsg)
-      sqlite3_free(errmsg);
+  if (success && ExecuteStatement(kCommitStatement)) {
+    // Commits of this connection don't change data_version, so the cached
+    // sections are brought up to date here.
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+      auto cached = cache_.find(it->first.first);
+      if (cached == cache_.end())
+        continue;
+      if (it->second.first)
+        cached->second[it->first.second] = it->second.second;
+      else
+        cached->second.erase(it->first.second);
+    }
+    pending_.clear();
+    return;
   }
+
+  LOGGER(ERROR) << "Fail to write app db : " << sqlite3_errmsg(sqldb_);
+  ExecuteStatement(kRollbackStatement);
+  ScheduleRetry();
 }
 
 void SqliteDB::GetKeys(const std::string& section,
                        std::list<std::string>* keys) const {
-  char *buffer = NULL;
-  sqlite3_stmt *stmt = NULL;
-
-  int ret = 0;
-  buffer = sqlite3_mprintf(
-      "select key from appdb where section = %Q",
-      section.c_str());
-  if (buffer == NULL) {
-    LOGGER(ERROR) << "error to make query";
-    return;
+  ValueMap values;
+  GetAll(section, &values);
+  for (auto it = values.begin(); it != values.end(); ++it)
+    keys->push_back(it->first);
+}
+
+void SqliteDB::GetAll(const std::string& section,
+                      ValueMap* values) const {
+  const ValueMap* cached = LoadSection(section);
+  if (cached != NULL)
+    values->insert(cached->begin(), cached->end());
+
+  // Changes that aren't flushed yet take precedence.
+  auto it = pending_.lower_bound(PendingKey(section, std::string()));
+  for ( ; it != pending_.end() && it->first.first == section; ++it) {
+    if (it->second.first)
+      (*values)[it->first.second] = it->second.second;
+    else
+      values->erase(it->first.second);
   }
+}
 
-  std::unique_ptr<char, decltype(sqlite3_free)*>
-      scoped_data {buffer, sqlite3_free};
+void SqliteDB::OnLocalChange(const std::string& section) {
+  auto snapshot = snapshots_.find(section);
+  if (snapshot != snapshots_.end()) {
+    snapshot->second.clear();
+    GetAll(section, &snapshot->second);
+  }
+  NotifyChanged(section);
+}
 
-  ret = sqlite3_prepare(sqldb_, buffer, strlen(buffer), &stmt, NULL);
-  if (ret != SQLITE_OK) {
-    LOGGER(ERROR) << "Fail to prepare query : " << sqlite3_errmsg(sqldb_);
+int SqliteDB::AddChangeListener(const std::string& section,
+                                ChangeCallback callback) {
+  if (snapshots_.find(section) == snapshots_.end())
+    GetAll(section, &snapshots_[section]);
+  if (!poll_source_id_) {
+    polled_version_ = data_version_;
+    poll_source_id_ = g_timeout_add(kChangePollIntervalMs, PollCallback, this);
+  }
+  return AppDB::AddChangeListener(section, callback);
+}
+
+void SqliteDB::RemoveChangeListener(int listener_id) {
+  AppDB::RemoveChangeListener(listener_id);
+  for (auto it = snapshots_.begin(); it != snapshots_.end(); ) {
+    if (HasChangeListener(it->first))
+      ++it;
+    else
+      snapshots_.erase(it++);
+  }
+  if (snapshots_.empty() && poll_source_id_) {
+    g_source_remove(poll_source_id_);
+    poll_source_id_ = 0;
+  }
+}
+
+void SqliteDB::CheckRemoteChanges() {
+  ValidateCache();
+  if (data_version_ == polled_version_)
     return;
+  polled_version_ = data_version_;
+
+  std::list<std::string> changed;
+  for (auto it = snapshots_.begin(); it != snapshots_.end(); ++it) {
+    ValueMap values;
+    GetAll(it->first, &values);
+    if (values != it->second) {
+      it->second.swap(values);
+      changed.push_back(it->first);
+    }
   }
+  for (auto it = changed.begin(); it != changed.end(); ++it)
+    NotifyChanged(*it);
+}
 
-  ret = sqlite3_step(stmt);
-  while (ret == SQLITE_ROW) {
-    const char* value =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-    keys->push_back(std::string(value));
-    ret = sqlite3_step(stmt);
+// static
+gboolean SqliteDB::PollCallback(gpointer user_data) {
+  SqliteDB* self = static_cast<SqliteDB*>(user_data);
+  self->CheckRemoteChanges();
+  return TRUE;
+}
+
+#endif  // USE_APP_PREFERENCE
+
+AppDB::AppDB()
+    : next_listener_id_(1),
+      next_data_version_(0) {
+}
+
+AppDB::~AppDB() {
+}
+
+// static
+bool AppDB::CanDeferWrites() {
+  // A thread owns the default context while it runs the main loop.
+  return g_main_context_is_owner(g_main_context_default());
+}
+
+int AppDB::DataVersion() const {
+  return ++next_data_version_;
+}
+
+int AppDB::AddChangeListener(const std::string& section,
+                             ChangeCallback callback) {
+  int listener_id = next_listener_id_++;
+  listeners_[listener_id] = std::make_pair(section, callback);
+  return listener_id;
+}
+
+void AppDB::RemoveChangeListener(int listener_id) {
+  listeners_.erase(listener_id);
+}
+
+void AppDB::NotifyChanged(const std::string& section) {
+  // Listeners may add or remove listeners while they are called.
+  std::list<ChangeCallback> callbacks;
+  for (auto it = listeners_.begin(); it != listeners_.end(); ++it) {
+    if (it->second.first == section)
+      callbacks.push_back(it->second.second);
   }
+  for (auto it = callbacks.begin(); it != callbacks.end(); ++it)
+    (*it)(section);
+}
+
+bool AppDB::HasChangeListeners() const {
+  return !listeners_.empty();
+}
+
+bool AppDB::HasChangeListener(const std::string& section) const {
+  for (auto it = listeners_.begin(); it != listeners_.end(); ++it) {
+    if (it->second.first == section)
+      return true;
+  }
+  return false;
+}
 
-  sqlite3_finalize(stmt);
-  return;
+AppDB::Transaction::Transaction(AppDB* db)
+    : db_(db) {
+  db_->BeginTransaction();
 }
 
-#endif  // end of else
+AppDB::Transaction::~Transaction() {
+  db_->EndTransaction();
+}
 
 AppDB* AppDB::GetInstance() {
 #ifdef USE_APP_PREFERENCE
   static PreferenceAppDB instance;
+#elif defined(USE_APP_DB_LOG)
+  static LogDB instance;
 #else
   static SqliteDB instance;
 #endif
   return &instance;
 }
 
+AppDB* AppDB::CreateInstance() {
+#ifdef USE_APP_PREFERENCE
+  return new PreferenceAppDB();
+#elif defined(USE_APP_DB_LOG)
+  return new LogDB();
+#else
+  return new SqliteDB();
+#endif
+}
+
 }  // namespace common
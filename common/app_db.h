@@ -17,14 +17,38 @@
 #ifndef XWALK_COMMON_APP_DB_H_
 #define XWALK_COMMON_APP_DB_H_
 
+#include <functional>
 #include <list>
+#include <map>
 #include <string>
+#include <utility>
 
 namespace common {
 
 class AppDB {
  public:
+  typedef std::map<std::string, std::string> ValueMap;
+  typedef std::function<void(const std::string& section)> ChangeCallback;
+
+  // Groups the changes made while it is alive, so that they are written
+  // together and other processes see either all of them or none.
+  class Transaction {
+   public:
+    explicit Transaction(AppDB* db);
+    ~Transaction();
+
+   private:
+    AppDB* db_;
+  };
+
   static AppDB* GetInstance();
+  // Returns a new instance of the same backend with a connection of its
+  // own, for use on a thread other than the main one. Writes on it should
+  // be made inside a Transaction, so that they are written out together.
+  static AppDB* CreateInstance();
+
+  virtual ~AppDB();
+
   virtual bool HasKey(const std::string& section,
                       const std::string& key) const = 0;
   virtual std::string Get(const std::string& section,
@@ -32,10 +56,56 @@ class AppDB {
   virtual void Set(const std::string& section,
                    const std::string& key,
                    const std::string& value) = 0;
+  // Returns false if |key| doesn't exist, otherwise sets |value|.
+  virtual bool TryGet(const std::string& section,
+                      const std::string& key,
+                      std::string* value) const = 0;
   virtual void GetKeys(const std::string& section,
                        std::list<std::string>* keys) const = 0;
+  virtual void GetAll(const std::string& section,
+                      ValueMap* values) const = 0;
+  virtual void SetMany(const std::string& section,
+                       const ValueMap& values) = 0;
   virtual void Remove(const std::string& section,
                       const std::string& key) = 0;
+  virtual void RemoveMany(const std::string& section,
+                          const std::list<std::string>& keys) = 0;
+  // Writes changes that are still buffered in this process to the storage,
+  // so that other processes can see them.
+  virtual void Flush() = 0;
+
+  // Returns a number that changes whenever another process or another
+  // instance wrote to the storage since this instance last looked at it.
+  // Changes made through this instance leave it as it is. Backends that
+  // can't tell return a different number on every call.
+  virtual int DataVersion() const;
+
+  // |callback| is called on the main loop after values in |section| were
+  // changed, by this process or by another one. Returns an id to pass to
+  // RemoveChangeListener().
+  virtual int AddChangeListener(const std::string& section,
+                                ChangeCallback callback);
+  virtual void RemoveChangeListener(int listener_id);
+
+ protected:
+  AppDB();
+
+  virtual void BeginTransaction() = 0;
+  virtual void EndTransaction() = 0;
+
+  // Whether buffered writes can be left to a callback on the main loop.
+  // That is only the case on the thread running the default main loop,
+  // anywhere else they have to be written out right away.
+  static bool CanDeferWrites();
+
+  void NotifyChanged(const std::string& section);
+  bool HasChangeListener(const std::string& section) const;
+  bool HasChangeListeners() const;
+
+ private:
+  std::map<int, std::pair<std::string, ChangeCallback> > listeners_;
+  int next_listener_id_;
+  mutable int next_data_version_;
 };
 }  // namespace common
 
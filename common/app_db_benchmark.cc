@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Measures the latency of the sqlite, log and preference AppDB backends on
+// synthetic workloads and on replayed traces. The preference backend
+// ignores --path, app_preference keeps the values of the application the
+// benchmark runs as.
+//
+// A trace has one operation per line, '#' starts a comment:
+//   get <section> <key>
+//   has <section> <key>
+//   set <section> <key> <value, up to the end of the line>
+//   remove <section> <key>
+//   keys <section>
+//   all <section>
+//   flush
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/app_db.h"
+#include "common/app_db_log.h"
+#include "common/app_db_preference.h"
+#include "common/app_db_sqlite.h"
+#include "common/benchmark_utils.h"
+#include "common/picojson.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const char kSection[] = "benchmark";
+const char kDefaultBackend[] = "sqlite";
+const char kDefaultWorkloads[] = "get,set,set_batched,scan,mixed,contention";
+const int kDefaultKeys = 1000;
+const int kDefaultIterations = 10000;
+const int kDefaultValueSize = 64;
+const int kDefaultProcesses = 4;
+
+// One in this many operations of the mixed workload is a write.
+const int kMixedWriteRatio = 10;
+
+struct Options {
+  std::string path;
+  std::string backend;
+  std::string trace;
+  std::vector<std::string> workloads;
+  int keys;
+  int iterations;
+  int value_size;
+  int processes;
+};
+
+struct Result {
+  std::string workload;
+  double seconds;
+  std::vector<double> latencies_us;
+};
+
+std::string KeyName(int index) {
+  std::ostringstream key;
+  key << "key" << index;
+  return key.str();
+}
+
+double Percentile(const std::vector<double>& sorted, double percentile) {
+  if (sorted.empty())
+    return 0;
+  size_t index = static_cast<size_t>(percentile * (sorted.size() - 1));
+  return sorted[index];
+}
+
+void PrintResult(const Options& options, Result* result) {
+  std::vector<double>& latencies = result->latencies_us;
+  std::sort(latencies.begin(), latencies.end());
+
+  picojson::object json;
+  json["backend"] = picojson::value(options.backend);
+  json["workload"] = picojson::value(result->workload);
+  json["keys"] = picojson::value(static_cast<double>(options.keys));
+  json["value_size"] = picojson::value(static_cast<double>(options.value_size));
+  json["ops"] = picojson::value(static_cast<double>(latencies.size()));
+  json["seconds"] = picojson::value(result->seconds);
+  json["ops_per_sec"] = picojson::value(
+      result->seconds > 0 ? latencies.size() / result->seconds : 0);
+  json["p50_us"] = picojson::value(Percentile(latencies, 0.5));
+  json["p99_us"] = picojson::value(Percentile(latencies, 0.99));
+  json["max_us"] = picojson::value(latencies.empty() ? 0 : latencies.back());
+  benchmark::PrintResult(json);
+}
+
+// Runs |op| |count| times and records the latency of every call.
+template <typename Operation>
+void Measure(int count, Result* result, Operation op) {
+  result->latencies_us.reserve(result->latencies_us.size() + count);
+  double start = benchmark::Now();
+  for (int i = 0; i < count; ++i) {
+    double op_start = benchmark::Now();
+    op(i);
+    result->latencies_us.push_back((benchmark::Now() - op_start) * 1e6);
+  }
+  result->seconds += benchmark::Now() - start;
+}
+
+void Populate(common::AppDB* db, const Options& options) {
+  common::AppDB::ValueMap values;
+  std::string value(options.value_size, 'v');
+  for (int i = 0; i < options.keys; ++i)
+    values[KeyName(i)] = value;
+  db->SetMany(kSection, values);
+  db->Flush();
+}
+
+class Benchmark {
+ public:
+  Benchmark(common::AppDB* db, const Options& options, unsigned int seed)
+      : db_(db), options_(options), seed_(seed),
+        value_(options.value_size, 'w') {}
+
+  void Run(const std::string& workload) {
+    Result result;
+    result.workload = workload;
+    result.seconds = 0;
+    if (workload == "get") {
+      Get(&result);
+    } else if (workload == "set") {
+      Set(&result, true);
+    } else if (workload == "set_batched") {
+      Set(&result, false);
+    } else if (workload == "scan") {
+      Scan(&result);
+    } else if (workload == "mixed") {
+      Mixed(&result);
+    } else if (workload == "replay") {
+      if (!Replay(&result))
+        return;
+    } else {
+      fprintf(stderr, "Unknown workload : %s\n", workload.c_str());
+      return;
+    }
+    PrintResult(options_, &result);
+  }
+
+  void Get(Result* result) {
+    std::string value;
+    Measure(options_.iterations, result, [this, &value](int /*index*/) {
+      db_->TryGet(kSection, RandomKey(), &value);
+    });
+  }
+
+  // Every set is written out on its own, or all of them at the end.
+  void Set(Result* result, bool flush_each) {
+    Measure(options_.iterations, result, [this, flush_each](int /*index*/) {
+      db_->Set(kSection, RandomKey(), value_);
+      if (flush_each)
+        db_->Flush();
+    });
+    if (!flush_each)
+      Measure(1, result, [this](int /*index*/) { db_->Flush(); });
+  }
+
+  void Scan(Result* result) {
+    int count = std::max(options_.iterations / options_.keys, 1);
+    Measure(count, result, [this](int /*index*/) {
+      std::list<std::string> keys;
+      db_->GetKeys(kSection, &keys);
+    });
+  }
+
+  void Mixed(Result* result) {
+    std::string value;
+    Measure(options_.iterations, result, [this, &value](int index) {
+      if (index % kMixedWriteRatio == 0) {
+        db_->Set(kSection, RandomKey(), value_);
+        db_->Flush();
+      } else {
+        db_->TryGet(kSection, RandomKey(), &value);
+      }
+    });
+  }
+
+  bool Replay(Result* result) {
+    std::ifstream trace(options_.trace.c_str());
+    if (!trace.is_open()) {
+      fprintf(stderr, "Fail to open trace : %s\n", options_.trace.c_str());
+      return false;
+    }
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(trace, line)) {
+      size_t begin = line.find_first_not_of(" \t");
+      if (begin != std::string::npos && line[begin] != '#')
+        lines.push_back(line.substr(begin));
+    }
+    Measure(lines.size(), result, [this, &lines](int index) {
+      ReplayLine(lines[index]);
+    });
+    return true;
+  }
+
+ private:
+  std::string RandomKey() {
+    return KeyName(rand_r(&seed_) % options_.keys);
+  }
+
+  void ReplayLine(const std::string& line) {
+    std::istringstream stream(line);
+    std::string op, section, key;
+    stream >> op >> section >> key;
+    if (op == "get") {
+      std::string value;
+      db_->TryGet(section, key, &value);
+    } else if (op == "has") {
+      db_->HasKey(section, key);
+    } else if (op == "set") {
+      std::string value;
+      std::getline(stream >> std::ws, value);
+      db_->Set(section, key, value);
+    } else if (op == "remove") {
+      db_->Remove(section, key);
+    } else if (op == "keys") {
+      std::list<std::string> keys;
+      db_->GetKeys(section, &keys);
+    } else if (op == "all") {
+      common::AppDB::ValueMap values;
+      db_->GetAll(section, &values);
+    } else if (op == "flush") {
+      db_->Flush();
+    }
+  }
+
+  common::AppDB* db_;
+  const Options& options_;
+  unsigned int seed_;
+  std::string value_;
+};
+
+template <typename DB>
+DB* NewDB(const Options& options) {
+  return new DB(options.path);
+}
+
+template <>
+common::PreferenceAppDB* NewDB<common::PreferenceAppDB>(
+    const Options& /*options*/) {
+  return new common::PreferenceAppDB();
+}
+
+template <typename DB>
+void RunMixedInChild(const Options& options, int seed, int fd) {
+  std::unique_ptr<DB> db(NewDB<DB>(options));
+  Benchmark benchmark(db.get(), options, seed);
+  Result result;
+  result.seconds = 0;
+  benchmark.Mixed(&result);
+  for (auto it = result.latencies_us.begin();
+       it != result.latencies_us.end(); ++it) {
+    double latency = *it;
+    if (write(fd, &latency, sizeof(latency)) != sizeof(latency))
+      break;
+  }
+}
+
+// Runs the mixed workload in |options.processes| processes at once, the
+// way the runtime, the extension process and the renderer share the
+// database.
+template <typename DB>
+void RunContention(const Options& options) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    perror("pipe");
+    return;
+  }
+
+  Result result;
+  result.workload = "contention";
+  double start = benchmark::Now();
+  std::vector<pid_t> children;
+  for (int i = 0; i < options.processes; ++i) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      RunMixedInChild<DB>(options, i + 1, fds[1]);
+      close(fds[1]);
+      _exit(0);
+    }
+    if (pid > 0)
+      children.push_back(pid);
+  }
+  close(fds[1]);
+
+  double latency;
+  while (read(fds[0], &latency, sizeof(latency)) == sizeof(latency))
+    result.latencies_us.push_back(latency);
+  close(fds[0]);
+  for (auto it = children.begin(); it != children.end(); ++it)
+    waitpid(*it, NULL, 0);
+  result.seconds = benchmark::Now() - start;
+  PrintResult(options, &result);
+}
+
+template <typename DB>
+void RunAll(const Options& options) {
+  {
+    std::unique_ptr<DB> db(NewDB<DB>(options));
+    Populate(db.get(), options);
+    Benchmark benchmark(db.get(), options, 1);
+    for (auto it = options.workloads.begin();
+         it != options.workloads.end(); ++it) {
+      if (*it != "contention")
+        benchmark.Run(*it);
+    }
+    if (!options.trace.empty())
+      benchmark.Run("replay");
+  }
+  if (std::find(options.workloads.begin(), options.workloads.end(),
+                "contention") != options.workloads.end())
+    RunContention<DB>(options);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options command_line(argc, argv);
+  Options options;
+  options.path = command_line.Required("path", "<existing directory>");
+  options.backend = command_line.String("backend", kDefaultBackend);
+  options.trace = command_line.String("trace", "");
+  options.workloads = command_line.List("workloads", kDefaultWorkloads);
+  options.keys = command_line.Int("keys", kDefaultKeys);
+  options.iterations = command_line.Int("iterations", kDefaultIterations);
+  options.value_size = command_line.Int("value-size", kDefaultValueSize);
+  options.processes = command_line.Int("processes", kDefaultProcesses);
+
+  struct stat st;
+  if (options.path.empty() || stat(options.path.c_str(), &st) != 0 ||
+      !S_ISDIR(st.st_mode))
+    return command_line.Usage();
+
+  if (options.backend == "sqlite") {
+    RunAll<common::SqliteDB>(options);
+  } else if (options.backend == "log") {
+    RunAll<common::LogDB>(options);
+  } else if (options.backend == "preference") {
+    RunAll<common::PreferenceAppDB>(options);
+  } else {
+    fprintf(stderr, "Unknown backend : %s, use sqlite, log or preference\n",
+            options.backend.c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
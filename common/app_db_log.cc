@@ -0,0 +1,677 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+#include "common/app_db_log.h"
+
+#include <app.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "common/logger.h"
+
+namespace common {
+
+namespace {
+
+// The log starts with kLogMagic, followed by frames of
+//   uint32 payload size, uint32 crc32 of the payload, payload
+// and each payload is a sequence of entries of
+//   uint8 type, uint32 section size, uint32 key size, uint32 value size,
+//   section, key, value
+// in host byte order.
+const char kLogFileName[] = "/.appdb.log";
+const char kLockFileName[] = "/.appdb.log.lock";
+const char kCompactFileSuffix[] = ".compact";
+const char kLogMagic[] = {'X', 'W', 'A', 'P', 'P', 'D', 'B', '1'};
+const size_t kLogHeaderSize = sizeof(kLogMagic);
+const size_t kFrameHeaderSize = 2 * sizeof(uint32_t);
+const size_t kEntryHeaderSize = 1 + 3 * sizeof(uint32_t);
+
+enum EntryType {
+  kSetEntry = 1,
+  kRemoveEntry = 2
+};
+
+// The log is rewritten with only the live entries once it is at least
+// this large and more than half of it is overwritten or removed entries.
+const size_t kCompactionMinSize = 64 * 1024;
+
+// How often sections with change listeners are checked for frames written
+// by other processes.
+const guint kChangePollIntervalMs = 500;
+
+// A flush that failed is tried again after this delay.
+const guint kFlushRetryDelayMs = 1000;
+
+// Reads check the log for frames of other processes at most this often.
+const gint64 kRefreshIntervalUs = 100 * 1000;
+
+class Crc32Table {
+ public:
+  Crc32Table() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit)
+        crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+      table_[i] = crc;
+    }
+  }
+  uint32_t Compute(const char* data, size_t length) const {
+    uint32_t crc = 0xFFFFFFFF;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; ++i)
+      crc = table_[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+  }
+
+ private:
+  uint32_t table_[256];
+};
+
+uint32_t Crc32(const char* data, size_t length) {
+  static const Crc32Table table;
+  return table.Compute(data, length);
+}
+
+uint32_t ReadUint32(const char* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void AppendUint32(std::string* out, uint32_t value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+size_t EntrySize(const std::string& section, const std::string& key,
+                 size_t value_length) {
+  return kEntryHeaderSize + section.size() + key.size() + value_length;
+}
+
+void AppendEntry(std::string* out, EntryType type,
+                 const std::string& section, const std::string& key,
+                 const char* value, size_t value_length) {
+  out->push_back(static_cast<char>(type));
+  AppendUint32(out, section.size());
+  AppendUint32(out, key.size());
+  AppendUint32(out, value_length);
+  out->append(section);
+  out->append(key);
+  out->append(value, value_length);
+}
+
+void AppendFrameHeader(std::string* out, const std::string& payload) {
+  AppendUint32(out, payload.size());
+  AppendUint32(out, Crc32(payload.data(), payload.size()));
+}
+
+bool WriteAt(int fd, const std::string& data, off_t offset) {
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t ret = pwrite(fd, data.data() + written, data.size() - written,
+                         offset + written);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    written += ret;
+  }
+  return true;
+}
+
+}  // namespace
+
+LogDB::LogDB(const std::string& app_data_path)
+    : lock_fd_(-1),
+      write_locked_(false),
+      fd_(-1),
+      inode_(0),
+      refreshed_time_(0),
+      map_(NULL),
+      map_size_(0),
+      indexed_end_(0),
+      live_bytes_(0),
+      remote_version_(0),
+      poll_source_id_(0),
+      flush_source_id_(0),
+      transaction_depth_(0) {
+  std::string data_path = app_data_path;
+  if (data_path.empty()) {
+    std::unique_ptr<char, decltype(std::free)*>
+    path {app_get_data_path(), std::free};
+    if (path.get() != NULL)
+      data_path = path.get();
+  }
+  if (data_path.empty()) {
+    LOGGER(ERROR) << "app data path was empty";
+    return;
+  }
+  log_path_ = data_path + kLogFileName;
+  lock_path_ = data_path + kLockFileName;
+}
+
+LogDB::~LogDB() {
+  // A failed Flush() schedules a retry, which is removed right after.
+  Flush();
+  if (flush_source_id_)
+    g_source_remove(flush_source_id_);
+  if (poll_source_id_)
+    g_source_remove(poll_source_id_);
+  Close();
+  if (lock_fd_ >= 0)
+    close(lock_fd_);
+}
+
+bool LogDB::Open() const {
+  Close();
+  fd_ = open(log_path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd_ < 0) {
+    LOGGER(ERROR) << "Fail to open app db log : " << strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    LOGGER(ERROR) << "Fail to stat app db log : " << strerror(errno);
+    Close();
+    return false;
+  }
+  inode_ = st.st_ino;
+  return true;
+}
+
+void LogDB::Close() const {
+  if (map_ != NULL)
+    munmap(map_, map_size_);
+  if (fd_ >= 0)
+    close(fd_);
+  fd_ = -1;
+  inode_ = 0;
+  map_ = NULL;
+  map_size_ = 0;
+  indexed_end_ = 0;
+  live_bytes_ = 0;
+  index_.clear();
+}
+
+void LogDB::Refresh(bool force) const {
+  if (log_path_.empty())
+    return;
+
+  gint64 now = g_get_monotonic_time();
+  if (!force && fd_ >= 0 && now - refreshed_time_ < kRefreshIntervalUs)
+    return;
+  refreshed_time_ = now;
+
+  struct stat st;
+  if (stat(log_path_.c_str(), &st) != 0)
+    return;
+
+  if (fd_ < 0 || st.st_ino != inode_) {
+    // First use, or another process has compacted the log. Everything is
+    // indexed again, and all sections are treated as changed.
+    std::list<std::string> sections;
+    for (auto it = index_.begin(); it != index_.end(); ++it)
+      sections.push_back(it->first);
+    bool reopened = fd_ >= 0;
+    if (!Open())
+      return;
+    // Whatever is in the file was written by other processes, this one
+    // opens the log itself before appending to it.
+    ++remote_version_;
+    if (reopened) {
+      for (auto it = sections.begin(); it != sections.end(); ++it) {
+        if (HasChangeListener(*it))
+          remote_changes_.insert(*it);
+      }
+    }
+    ScanToEnd(reopened);
+    return;
+  }
+
+  // The size can also shrink, when a writer cuts off a torn tail before
+  // appending its own frame.
+  if (static_cast<size_t>(st.st_size) > indexed_end_)
+    ScanToEnd(true);
+}
+
+void LogDB::ScanToEnd(bool remote) const {
+  // A writer may cut off what follows the indexed frames, so it is only
+  // read under a lock. Without the lock file it is read anyway, as before.
+  bool shared_lock = !write_locked_ && Lock(LOCK_SH);
+  struct stat st;
+  if (fstat(fd_, &st) == 0) {
+    size_t size = st.st_size;
+    if (size > indexed_end_ && (size == map_size_ || Map(size)))
+      Scan(remote);
+  }
+  if (shared_lock)
+    flock(lock_fd_, LOCK_UN);
+}
+
+bool LogDB::Map(size_t size) const {
+  if (map_ != NULL)
+    munmap(map_, map_size_);
+  map_ = NULL;
+  map_size_ = 0;
+  void* map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (map == MAP_FAILED) {
+    LOGGER(ERROR) << "Fail to map app db log : " << strerror(errno);
+    return false;
+  }
+  map_ = static_cast<char*>(map);
+  map_size_ = size;
+  return true;
+}
+
+void LogDB::Scan(bool remote) const {
+  size_t offset = indexed_end_;
+  if (offset == 0) {
+    if (map_size_ < kLogHeaderSize)
+      return;
+    if (memcmp(map_, kLogMagic, kLogHeaderSize) != 0) {
+      LOGGER(ERROR) << "Invalid app db log header";
+      return;
+    }
+    offset = kLogHeaderSize;
+  }
+
+  while (map_size_ - offset >= kFrameHeaderSize) {
+    uint32_t size = ReadUint32(map_ + offset);
+    uint32_t crc = ReadUint32(map_ + offset + sizeof(uint32_t));
+    size_t payload = offset + kFrameHeaderSize;
+    if (size > map_size_ - payload)
+      break;
+    if (Crc32(map_ + payload, size) != crc)
+      break;
+    if (!ApplyFrame(payload, size, remote))
+      break;
+    offset = payload + size;
+  }
+  if (remote && offset != indexed_end_)
+    ++remote_version_;
+  indexed_end_ = offset;
+}
+
+bool LogDB::ApplyFrame(size_t offset, size_t size, bool remote) const {
+  const size_t end = offset + size;
+
+  // The checksum matched, but entries are still checked to stay within the
+  // frame before any of them is applied.
+  for (size_t pos = offset; pos < end; ) {
+    if (end - pos < kEntryHeaderSize)
+      return false;
+    size_t length = static_cast<size_t>(ReadUint32(map_ + pos + 1)) +
+                    ReadUint32(map_ + pos + 1 + sizeof(uint32_t)) +
+                    ReadUint32(map_ + pos + 1 + 2 * sizeof(uint32_t));
+    if (length > end - pos - kEntryHeaderSize)
+      return false;
+    pos += kEntryHeaderSize + length;
+  }
+
+  for (size_t pos = offset; pos < end; ) {
+    int type = map_[pos];
+    size_t section_size = ReadUint32(map_ + pos + 1);
+    size_t key_size = ReadUint32(map_ + pos + 1 + sizeof(uint32_t));
+    size_t value_size = ReadUint32(map_ + pos + 1 + 2 * sizeof(uint32_t));
+    const char* data = map_ + pos + kEntryHeaderSize;
+    std::string section(data, section_size);
+    std::string key(data + section_size, key_size);
+    ValueLocation location = {
+      pos + kEntryHeaderSize + section_size + key_size, value_size
+    };
+    pos += kEntryHeaderSize + section_size + key_size + value_size;
+
+    KeyIndex& keys = index_[section];
+    auto existing = keys.find(key);
+    if (existing != keys.end()) {
+      live_bytes_ -= EntrySize(section, key, existing->second.length);
+      if (type != kSetEntry)
+        keys.erase(existing);
+    }
+    if (type == kSetEntry) {
+      keys[key] = location;
+      live_bytes_ += EntrySize(section, key, value_size);
+    }
+    if (remote && HasChangeListener(section))
+      remote_changes_.insert(section);
+  }
+  return true;
+}
+
+const LogDB::ValueLocation* LogDB::FindValue(const std::string& section,
+                                             const std::string& key) const {
+  Refresh();
+  auto keys = index_.find(section);
+  if (keys == index_.end())
+    return NULL;
+  auto found = keys->second.find(key);
+  if (found == keys->second.end())
+    return NULL;
+  return &found->second;
+}
+
+bool LogDB::HasKey(const std::string& section,
+                   const std::string& key) const {
+  auto pending = pending_.find(PendingKey(section, key));
+  if (pending != pending_.end())
+    return pending->second.first;
+  return FindValue(section, key) != NULL;
+}
+
+std::string LogDB::Get(const std::string& section,
+                       const std::string& key) const {
+  std::string result;
+  TryGet(section, key, &result);
+  return result;
+}
+
+bool LogDB::TryGet(const std::string& section,
+                   const std::string& key,
+                   std::string* value) const {
+  auto pending = pending_.find(PendingKey(section, key));
+  if (pending != pending_.end()) {
+    if (pending->second.first)
+      *value = pending->second.second;
+    return pending->second.first;
+  }
+
+  const ValueLocation* location = FindValue(section, key);
+  if (location == NULL)
+    return false;
+  value->assign(map_ + location->offset, location->length);
+  return true;
+}
+
+void LogDB::GetKeys(const std::string& section,
+                    std::list<std::string>* keys) const {
+  ValueMap values;
+  GetAll(section, &values);
+  for (auto it = values.begin(); it != values.end(); ++it)
+    keys->push_back(it->first);
+}
+
+void LogDB::GetAll(const std::string& section,
+                   ValueMap* values) const {
+  Refresh();
+  auto keys = index_.find(section);
+  if (keys != index_.end()) {
+    for (auto it = keys->second.begin(); it != keys->second.end(); ++it) {
+      (*values)[it->first].assign(map_ + it->second.offset,
+                                  it->second.length);
+    }
+  }
+
+  // Changes that aren't flushed yet take precedence.
+  auto it = pending_.lower_bound(PendingKey(section, std::string()));
+  for ( ; it != pending_.end() && it->first.first == section; ++it) {
+    if (it->second.first)
+      (*values)[it->first.second] = it->second.second;
+    else
+      values->erase(it->first.second);
+  }
+}
+
+void LogDB::Set(const std::string& section,
+                const std::string& key,
+                const std::string& value) {
+  pending_[PendingKey(section, key)] = std::make_pair(true, value);
+  ScheduleFlush();
+  NotifyChanged(section);
+}
+
+void LogDB::SetMany(const std::string& section,
+                    const ValueMap& values) {
+  for (auto it = values.begin(); it != values.end(); ++it) {
+    pending_[PendingKey(section, it->first)] =
+        std::make_pair(true, it->second);
+  }
+  ScheduleFlush();
+  NotifyChanged(section);
+}
+
+void LogDB::Remove(const std::string& section,
+                   const std::string& key) {
+  pending_[PendingKey(section, key)] = std::make_pair(false, std::string());
+  ScheduleFlush();
+  NotifyChanged(section);
+}
+
+void LogDB::RemoveMany(const std::string& section,
+                       const std::list<std::string>& keys) {
+  for (auto it = keys.begin(); it != keys.end(); ++it) {
+    pending_[PendingKey(section, *it)] = std::make_pair(false, std::string());
+  }
+  ScheduleFlush();
+  NotifyChanged(section);
+}
+
+void LogDB::BeginTransaction() {
+  transaction_depth_++;
+}
+
+void LogDB::EndTransaction() {
+  if (transaction_depth_ > 0 && --transaction_depth_ == 0)
+    Flush();
+}
+
+bool LogDB::Lock(int operation) const {
+  if (lock_fd_ < 0) {
+    lock_fd_ = open(lock_path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (lock_fd_ < 0) {
+      LOGGER(ERROR) << "Fail to open app db lock : " << strerror(errno);
+      return false;
+    }
+  }
+  while (flock(lock_fd_, operation) != 0) {
+    if (errno != EINTR) {
+      LOGGER(ERROR) << "Fail to lock app db : " << strerror(errno);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LogDB::LockForWrite() {
+  if (!Lock(LOCK_EX))
+    return false;
+  write_locked_ = true;
+  // Frames written by other processes have to be indexed before ours is
+  // appended after them.
+  Refresh(true);
+  return true;
+}
+
+void LogDB::Unlock() {
+  write_locked_ = false;
+  flock(lock_fd_, LOCK_UN);
+}
+
+bool LogDB::AppendFrame(const std::string& payload) {
+  if (fd_ < 0 && !Open())
+    return false;
+
+  // A new or unreadable log starts over with a header. Otherwise anything
+  // after the last valid frame is a torn write and is cut off. This runs
+  // under the exclusive lock, after LockForWrite() mapped the whole file,
+  // and readers only look past their indexed frames under the shared lock.
+  std::string data;
+  if (indexed_end_ == 0)
+    data.append(kLogMagic, kLogHeaderSize);
+  AppendFrameHeader(&data, payload);
+  data.append(payload);
+
+  struct stat st;
+  if (fstat(fd_, &st) != 0 ||
+      (static_cast<size_t>(st.st_size) != indexed_end_ &&
+       ftruncate(fd_, indexed_end_) != 0)) {
+    LOGGER(ERROR) << "Fail to prepare app db log : " << strerror(errno);
+    return false;
+  }
+
+  size_t expected_end = indexed_end_ + data.size();
+  if (!WriteAt(fd_, data, indexed_end_) || fdatasync(fd_) != 0) {
+    LOGGER(ERROR) << "Fail to write app db log : " << strerror(errno);
+    if (ftruncate(fd_, indexed_end_) != 0)
+      LOGGER(ERROR) << "Fail to truncate app db log : " << strerror(errno);
+    return false;
+  }
+
+  if (!Map(expected_end))
+    return false;
+  Scan(false);
+  return indexed_end_ == expected_end;
+}
+
+void LogDB::Compact() {
+  if (indexed_end_ < kCompactionMinSize || live_bytes_ * 2 > indexed_end_)
+    return;
+
+  std::string payload;
+  payload.reserve(live_bytes_);
+  for (auto section = index_.begin(); section != index_.end(); ++section) {
+    const KeyIndex& keys = section->second;
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+      AppendEntry(&payload, kSetEntry, section->first, it->first,
+                  map_ + it->second.offset, it->second.length);
+    }
+  }
+  std::string data(kLogMagic, kLogHeaderSize);
+  AppendFrameHeader(&data, payload);
+  data.append(payload);
+
+  // The new log is complete on disk before it replaces the old one, so a
+  // crash leaves one or the other.
+  std::string compact_path = log_path_ + kCompactFileSuffix;
+  int fd = open(compact_path.c_str(),
+                O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    LOGGER(ERROR) << "Fail to create compacted app db log : "
+                  << strerror(errno);
+    return;
+  }
+  bool success = WriteAt(fd, data, 0) && fsync(fd) == 0;
+  close(fd);
+  if (!success || rename(compact_path.c_str(), log_path_.c_str()) != 0) {
+    LOGGER(ERROR) << "Fail to compact app db log : " << strerror(errno);
+    unlink(compact_path.c_str());
+    return;
+  }
+
+  if (Open() && Map(data.size()))
+    Scan(false);
+}
+
+void LogDB::Flush() {
+  if (pending_.empty() || log_path_.empty() || transaction_depth_ > 0)
+    return;
+
+  std::string payload;
+  for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+    const PendingKey& key = it->first;
+    const std::string& value = it->second.second;
+    AppendEntry(&payload, it->second.first ? kSetEntry : kRemoveEntry,
+                key.first, key.second, value.data(), value.size());
+  }
+
+  if (!LockForWrite()) {
+    ScheduleRetry();
+    return;
+  }
+  if (AppendFrame(payload)) {
+    pending_.clear();
+    Compact();
+  } else {
+    ScheduleRetry();
+  }
+  Unlock();
+}
+
+void LogDB::ScheduleFlush() {
+  // A Transaction flushes when it ends.
+  if (flush_source_id_ || transaction_depth_ > 0)
+    return;
+  if (CanDeferWrites())
+    flush_source_id_ = g_idle_add(FlushCallback, this);
+  else
+    Flush();
+}
+
+void LogDB::ScheduleRetry() {
+  // The changes stay buffered. Without a main loop, the next change or
+  // Flush() tries again.
+  if (!flush_source_id_ && CanDeferWrites())
+    flush_source_id_ = g_timeout_add(kFlushRetryDelayMs, FlushCallback, this);
+}
+
+// static
+gboolean LogDB::FlushCallback(gpointer user_data) {
+  LogDB* self = static_cast<LogDB*>(user_data);
+  self->flush_source_id_ = 0;
+  self->Flush();
+  return FALSE;
+}
+
+int LogDB::DataVersion() const {
+  Refresh();
+  return remote_version_;
+}
+
+int LogDB::AddChangeListener(const std::string& section,
+                             ChangeCallback callback) {
+  if (!poll_source_id_) {
+    Refresh();
+    remote_changes_.clear();
+    poll_source_id_ = g_timeout_add(kChangePollIntervalMs, PollCallback, this);
+  }
+  return AppDB::AddChangeListener(section, callback);
+}
+
+void LogDB::RemoveChangeListener(int listener_id) {
+  AppDB::RemoveChangeListener(listener_id);
+  if (!HasChangeListeners() && poll_source_id_) {
+    g_source_remove(poll_source_id_);
+    poll_source_id_ = 0;
+  }
+}
+
+void LogDB::CheckRemoteChanges() {
+  Refresh();
+  std::set<std::string> changed;
+  changed.swap(remote_changes_);
+  for (auto it = changed.begin(); it != changed.end(); ++it)
+    NotifyChanged(*it);
+}
+
+// static
+gboolean LogDB::PollCallback(gpointer user_data) {
+  LogDB* self = static_cast<LogDB*>(user_data);
+  self->CheckRemoteChanges();
+  return TRUE;
+}
+
+}  // namespace common
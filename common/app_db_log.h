@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+#ifndef XWALK_COMMON_APP_DB_LOG_H_
+#define XWALK_COMMON_APP_DB_LOG_H_
+
+#include <glib.h>
+#include <sys/types.h>
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/app_db.h"
+
+namespace common {
+
+// Keeps the database as an append-only log of checksummed frames, each
+// holding the changes written by one Flush(). Each process mmaps the log
+// and builds an in-memory hash table of value locations by scanning it, so
+// that reads neither parse nor copy anything but the result. The index
+// itself is not stored. Frames appended by other processes are picked up
+// by checking the file size, and a compaction done by another process by
+// checking the inode of the log file.
+class LogDB : public AppDB {
+ public:
+  explicit LogDB(const std::string& app_data_path = std::string());
+  ~LogDB();
+  virtual bool HasKey(const std::string& section,
+                      const std::string& key) const;
+  virtual std::string Get(const std::string& section,
+                          const std::string& key) const;
+  virtual void Set(const std::string& section,
+                   const std::string& key,
+                   const std::string& value);
+  virtual bool TryGet(const std::string& section,
+                      const std::string& key,
+                      std::string* value) const;
+  virtual void GetKeys(const std::string& section,
+                       std::list<std::string>* keys) const;
+  virtual void GetAll(const std::string& section,
+                      ValueMap* values) const;
+  virtual void SetMany(const std::string& section,
+                       const ValueMap& values);
+  virtual void Remove(const std::string& section,
+                      const std::string& key);
+  virtual void RemoveMany(const std::string& section,
+                          const std::list<std::string>& keys);
+  virtual void Flush();
+  virtual int DataVersion() const;
+  virtual int AddChangeListener(const std::string& section,
+                                ChangeCallback callback);
+  virtual void RemoveChangeListener(int listener_id);
+
+ protected:
+  virtual void BeginTransaction();
+  virtual void EndTransaction();
+
+ private:
+  // Where the value of a key is stored in the log.
+  struct ValueLocation {
+    size_t offset;
+    size_t length;
+  };
+  typedef std::unordered_map<std::string, ValueLocation> KeyIndex;
+  typedef std::unordered_map<std::string, KeyIndex> SectionIndex;
+
+  // (section, key) -> (true, value) for a set, (false, "") for a removal.
+  typedef std::pair<std::string, std::string> PendingKey;
+  typedef std::map<PendingKey, std::pair<bool, std::string> > PendingMap;
+
+  bool Open() const;
+  void Close() const;
+  // Picks up changes of other processes. Unless |force| is set, the file is
+  // checked at most once per kRefreshIntervalUs.
+  void Refresh(bool force = false) const;
+  bool Map(size_t size) const;
+  void ScanToEnd(bool remote) const;
+  void Scan(bool remote) const;
+  bool ApplyFrame(size_t offset, size_t size, bool remote) const;
+  const ValueLocation* FindValue(const std::string& section,
+                                 const std::string& key) const;
+  bool Lock(int operation) const;
+  bool LockForWrite();
+  void Unlock();
+  bool AppendFrame(const std::string& payload);
+  void Compact();
+  void ScheduleFlush();
+  void ScheduleRetry();
+  static gboolean FlushCallback(gpointer user_data);
+  void CheckRemoteChanges();
+  static gboolean PollCallback(gpointer user_data);
+
+  std::string log_path_;
+  std::string lock_path_;
+  mutable int lock_fd_;
+  // Whether this process holds the exclusive lock.
+  bool write_locked_;
+
+  // The log file as of the last Refresh(). Frames are indexed up to
+  // |indexed_end_|; anything after it is a frame that is still being
+  // written, or the torn tail of a crashed writer, and is cut off by the
+  // next writer. That only happens under the exclusive lock, and readers
+  // hold the shared one while they read past |indexed_end_|, so no one
+  // touches pages past the end of the file.
+  mutable int fd_;
+  mutable ino_t inode_;
+  mutable gint64 refreshed_time_;
+  mutable char* map_;
+  mutable size_t map_size_;
+  mutable size_t indexed_end_;
+  mutable size_t live_bytes_;
+  mutable SectionIndex index_;
+  // Counts the times frames of other processes were indexed.
+  mutable int remote_version_;
+
+  // Sections with change listeners that other processes wrote to since
+  // the last poll.
+  mutable std::set<std::string> remote_changes_;
+  guint poll_source_id_;
+
+  // Set and Remove calls are buffered here and appended as one frame from
+  // an idle callback, on Flush() and at destruction. Where
+  // CanDeferWrites() is false they are appended right away instead. Inside
+  // a Transaction the buffer is only written when the outermost one ends.
+  PendingMap pending_;
+  guint flush_source_id_;
+  int transaction_depth_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_APP_DB_LOG_H_
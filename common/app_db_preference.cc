@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/app_db_preference.h"
+
+#include <app_preference.h>
+#include <glib.h>
+
+#include <cstdlib>
+#include <memory>
+
+#include "common/string_utils.h"
+
+namespace common {
+
+namespace {
+
+const char* kSectionPrefix = "_SECT_";
+const char* kSectionSuffix = "_SECT_";
+
+// Writes made through any instance in this process.
+gint g_write_count = 0;
+
+}  // namespace
+
+PreferenceAppDB::PreferenceAppDB()
+    : own_writes_(0) {
+}
+
+bool PreferenceAppDB::HasKey(const std::string& section,
+                             const std::string& key) const {
+  bool existed = false;
+  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
+  return preference_is_existing(combined_key.c_str(), &existed) == 0 && existed;
+}
+
+std::string PreferenceAppDB::Get(const std::string& section,
+                                 const std::string& key) const {
+  std::string value;
+  TryGet(section, key, &value);
+  return value;
+}
+
+bool PreferenceAppDB::TryGet(const std::string& section,
+                             const std::string& key,
+                             std::string* value) const {
+  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
+  char* buffer;
+  if (preference_get_string(combined_key.c_str(), &buffer) == 0) {
+    std::unique_ptr<char, decltype(std::free)*> ptr {buffer, std::free};
+    *value = std::string(buffer);
+    return true;
+  }
+  return false;
+}
+
+void PreferenceAppDB::Set(const std::string& section,
+                          const std::string& key,
+                          const std::string& value) {
+  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
+  preference_set_string(combined_key.c_str(), value.c_str());
+  CountWrite();
+  NotifyChanged(section);
+}
+
+void PreferenceAppDB::GetKeys(const std::string& section,
+                              std::list<std::string>* keys) const {
+  auto callback = [](const char* key, void *user_data) {
+    auto list = static_cast<std::list<std::string>*>(user_data);
+    if (utils::StartsWith(key, list->front())) {
+      list->push_back(key+list->front().size());
+    }
+    return true;
+  };
+  std::string key_prefix = kSectionPrefix + section + kSectionSuffix;
+  keys->push_front(key_prefix);
+  preference_foreach_item(callback, keys);
+  keys->pop_front();
+}
+
+void PreferenceAppDB::GetAll(const std::string& section,
+                             ValueMap* values) const {
+  std::list<std::string> keys;
+  GetKeys(section, &keys);
+  for (auto it = keys.begin(); it != keys.end(); ++it) {
+    std::string value;
+    if (TryGet(section, *it, &value))
+      (*values)[*it] = value;
+  }
+}
+
+void PreferenceAppDB::SetMany(const std::string& section,
+                              const ValueMap& values) {
+  for (auto it = values.begin(); it != values.end(); ++it) {
+    std::string combined_key =
+        kSectionPrefix + section + kSectionSuffix + it->first;
+    preference_set_string(combined_key.c_str(), it->second.c_str());
+  }
+  CountWrite();
+  NotifyChanged(section);
+}
+
+void PreferenceAppDB::Remove(const std::string& section,
+                             const std::string& key) {
+  std::string combined_key = kSectionPrefix + section + kSectionSuffix + key;
+  preference_remove(combined_key.c_str());
+  CountWrite();
+  NotifyChanged(section);
+}
+
+void PreferenceAppDB::RemoveMany(const std::string& section,
+                                 const std::list<std::string>& keys) {
+  for (auto it = keys.begin(); it != keys.end(); ++it) {
+    std::string combined_key = kSectionPrefix + section + kSectionSuffix + *it;
+    preference_remove(combined_key.c_str());
+  }
+  CountWrite();
+  NotifyChanged(section);
+}
+
+void PreferenceAppDB::Flush() {
+  // app_preference writes through on every call.
+}
+
+int PreferenceAppDB::DataVersion() const {
+  return g_atomic_int_get(&g_write_count) - own_writes_;
+}
+
+void PreferenceAppDB::CountWrite() {
+  g_atomic_int_inc(&g_write_count);
+  ++own_writes_;
+}
+
+void PreferenceAppDB::BeginTransaction() {
+  // app_preference has no transactions, changes are applied one by one.
+}
+
+void PreferenceAppDB::EndTransaction() {
+}
+
+}  // namespace common
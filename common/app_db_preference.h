@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_APP_DB_PREFERENCE_H_
+#define XWALK_COMMON_APP_DB_PREFERENCE_H_
+
+#include <list>
+#include <string>
+
+#include "common/app_db.h"
+
+namespace common {
+
+// Keeps the values in app_preference, with the section folded into each
+// key. Always built, so that the benchmarks can measure it, but only used
+// as the AppDB instance when USE_APP_PREFERENCE is defined.
+class PreferenceAppDB : public AppDB {
+ public:
+  PreferenceAppDB();
+  virtual bool HasKey(const std::string& section,
+                      const std::string& key) const;
+  virtual std::string Get(const std::string& section,
+                          const std::string& key) const;
+  virtual void Set(const std::string& section,
+                   const std::string& key,
+                   const std::string& value);
+  virtual bool TryGet(const std::string& section,
+                      const std::string& key,
+                      std::string* value) const;
+  virtual void GetKeys(const std::string& section,
+                       std::list<std::string>* keys) const;
+  virtual void GetAll(const std::string& section,
+                      ValueMap* values) const;
+  virtual void SetMany(const std::string& section,
+                       const ValueMap& values);
+  virtual void Remove(const std::string& section,
+                      const std::string& key);
+  virtual void RemoveMany(const std::string& section,
+                          const std::list<std::string>& keys);
+  virtual void Flush();
+  // Only changes made by other instances in this process are seen,
+  // app_preference doesn't tell about the ones of other processes.
+  virtual int DataVersion() const;
+
+ protected:
+  virtual void BeginTransaction();
+  virtual void EndTransaction();
+
+ private:
+  void CountWrite();
+
+  // Writes made through this instance.
+  int own_writes_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_APP_DB_PREFERENCE_H_
@@ -17,12 +17,17 @@
 #ifndef XWALK_COMMON_APP_DB_SQLITE_H_
 #define XWALK_COMMON_APP_DB_SQLITE_H_
 
+#include <glib.h>
+
 #include <list>
+#include <map>
 #include <string>
+#include <utility>
 
 #include "common/app_db.h"
 
 class sqlite3;
+class sqlite3_stmt;
 
 namespace common {
 class SqliteDB : public AppDB {
@@ -36,15 +41,86 @@ class SqliteDB : public AppDB {
   virtual void Set(const std::string& section,
                    const std::string& key,
                    const std::string& value);
+  virtual bool TryGet(const std::string& section,
+                      const std::string& key,
+                      std::string* value) const;
   virtual void GetKeys(const std::string& section,
                        std::list<std::string>* keys) const;
+  virtual void GetAll(const std::string& section,
+                      ValueMap* values) const;
+  virtual void SetMany(const std::string& section,
+                       const ValueMap& values);
   virtual void Remove(const std::string& section,
                       const std::string& key);
+  virtual void RemoveMany(const std::string& section,
+                          const std::list<std::string>& keys);
+  virtual void Flush();
+  virtual int DataVersion() const;
+  virtual int AddChangeListener(const std::string& section,
+                                ChangeCallback callback);
+  virtual void RemoveChangeListener(int listener_id);
+
+ protected:
+  virtual void BeginTransaction();
+  virtual void EndTransaction();
 
  private:
+  // Statements are prepared on first use and kept for the lifetime of the
+  // connection.
+  enum StatementId {
+    kSetStatement,
+    kRemoveStatement,
+    kGetAllStatement,
+    kDataVersionStatement,
+    kBeginStatement,
+    kCommitStatement,
+    kRollbackStatement,
+    kStatementCount
+  };
+
+  // (section, key) -> (true, value) for a set, (false, "") for a removal.
+  typedef std::pair<std::string, std::string> PendingKey;
+  typedef std::map<PendingKey, std::pair<bool, std::string> > PendingMap;
+
   void Initialize();
+  sqlite3_stmt* GetStatement(StatementId id) const;
+  bool BindText(sqlite3_stmt* stmt, int index, const std::string& text) const;
+  bool ExecuteStatement(StatementId id);
+  bool WriteValue(const std::string& section, const std::string& key,
+                  const std::string& value);
+  bool DeleteValue(const std::string& section, const std::string& key);
+  void ScheduleFlush();
+  void ScheduleRetry();
+  static gboolean FlushCallback(gpointer user_data);
+  void ValidateCache() const;
+  const ValueMap* LoadSection(const std::string& section) const;
+  void OnLocalChange(const std::string& section);
+  void CheckRemoteChanges();
+  static gboolean PollCallback(gpointer user_data);
+
   std::string app_data_path_;
   sqlite3* sqldb_;
+  mutable sqlite3_stmt* statements_[kStatementCount];
+
+  // Set and Remove calls are buffered here and written in one transaction
+  // from an idle callback, on Flush() and at destruction. Where
+  // CanDeferWrites() is false they are written right away instead. Inside
+  // a Transaction the buffer is only written when the outermost one ends.
+  PendingMap pending_;
+  guint flush_source_id_;
+  int transaction_depth_;
+
+  // Committed contents of the sections read so far. Other processes write
+  // to the same file, so the whole cache is dropped whenever
+  // "PRAGMA data_version" reports a commit from another connection.
+  mutable std::map<std::string, ValueMap> cache_;
+  mutable int data_version_;
+
+  // Sections with change listeners, as last seen by the poll, which
+  // detects changes from other processes.
+  std::map<std::string, ValueMap> snapshots_;
+  int polled_version_;
+  guint poll_source_id_;
 };
 
 }  //  namespace common
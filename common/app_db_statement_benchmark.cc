@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Measures what caching prepared statements in SqliteDB saves. Each
+// operation runs against the appdb table in two ways: the way SqliteDB used
+// to, formatting the SQL with sqlite3_mprintf and preparing it on every
+// call, and the way it does now, binding the arguments to a statement
+// prepared once. Writes run inside one transaction, so that commits don't
+// hide the difference.
+
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/benchmark_utils.h"
+#include "common/picojson.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const int kDefaultKeys = 1000;
+const int kDefaultIterations = 100000;
+
+const char kSection[] = "benchmark";
+const char kCreateQuery[] = "CREATE TABLE IF NOT EXISTS appdb ("
+                            "section TEXT, "
+                            "key TEXT, "
+                            "value TEXT,"
+                            "PRIMARY KEY(section, key));";
+
+// The queries SqliteDB formatted for every call.
+const char kHasFormat[] =
+    "select count(*) from appdb where section = %Q and key = %Q";
+const char kGetFormat[] =
+    "select value from appdb where section = %Q and key = %Q";
+const char kSetFormat[] =
+    "replace into appdb (section, key, value) values (%Q, %Q, %Q)";
+
+// The statements it prepares once now.
+const char kHasQuery[] =
+    "select 1 from appdb where section = ? and key = ?";
+const char kGetQuery[] =
+    "select value from appdb where section = ? and key = ?";
+const char kSetQuery[] =
+    "replace into appdb (section, key, value) values (?, ?, ?)";
+
+std::string KeyName(int index) {
+  std::ostringstream key;
+  key << "key" << index;
+  return key.str();
+}
+
+// Runs |sql| prepared for this call only, the way SqliteDB used to.
+bool RunFormatted(sqlite3* db, const char* format, const std::string& key,
+                  const std::string& value) {
+  char* sql = sqlite3_mprintf(format, kSection, key.c_str(), value.c_str());
+  sqlite3_stmt* stmt;
+  bool success = sqlite3_prepare(db, sql, -1, &stmt, NULL) == SQLITE_OK;
+  sqlite3_free(sql);
+  if (!success)
+    return false;
+  int ret = sqlite3_step(stmt);
+  sqlite3_finalize(stmt);
+  return ret == SQLITE_ROW || ret == SQLITE_DONE;
+}
+
+// Runs the cached |stmt| with new arguments, the way SqliteDB does now.
+bool RunCached(sqlite3_stmt* stmt, const std::string& key,
+               const std::string& value) {
+  sqlite3_bind_text(stmt, 1, kSection, -1, SQLITE_STATIC);
+  sqlite3_bind_text(stmt, 2, key.c_str(), key.length(), SQLITE_STATIC);
+  if (sqlite3_bind_parameter_count(stmt) > 2)
+    sqlite3_bind_text(stmt, 3, value.c_str(), value.length(), SQLITE_STATIC);
+  int ret = sqlite3_step(stmt);
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+  return ret == SQLITE_ROW || ret == SQLITE_DONE;
+}
+
+void PrintResult(const std::string& statements, const std::string& op,
+                 int ops, double seconds) {
+  picojson::object json;
+  json["statements"] = picojson::value(statements);
+  json["op"] = picojson::value(op);
+  json["ops"] = picojson::value(static_cast<double>(ops));
+  json["seconds"] = picojson::value(seconds);
+  json["ops_per_sec"] = picojson::value(seconds > 0 ? ops / seconds : 0);
+  benchmark::PrintResult(json);
+}
+
+// Returns false if a statement failed.
+bool Run(sqlite3* db, const char* op, const char* format, const char* query,
+         const std::vector<std::string>& keys, int iterations) {
+  bool write = format == kSetFormat;
+  std::string value(64, 'v');
+  bool success = true;
+
+  if (write)
+    sqlite3_exec(db, "begin", NULL, NULL, NULL);
+  double start = benchmark::Now();
+  for (int i = 0; success && i < iterations; ++i)
+    success = RunFormatted(db, format, keys[i % keys.size()], value);
+  double seconds = benchmark::Now() - start;
+  if (write)
+    sqlite3_exec(db, "commit", NULL, NULL, NULL);
+  PrintResult("formatted", op, iterations, seconds);
+
+  sqlite3_stmt* stmt;
+  if (sqlite3_prepare_v2(db, query, -1, &stmt, NULL) != SQLITE_OK)
+    return false;
+  if (write)
+    sqlite3_exec(db, "begin", NULL, NULL, NULL);
+  start = benchmark::Now();
+  for (int i = 0; success && i < iterations; ++i)
+    success = RunCached(stmt, keys[i % keys.size()], value);
+  seconds = benchmark::Now() - start;
+  if (write)
+    sqlite3_exec(db, "commit", NULL, NULL, NULL);
+  sqlite3_finalize(stmt);
+  PrintResult("cached", op, iterations, seconds);
+
+  return success;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  std::string path = options.Required("path", "<dir>");
+  int key_count = options.Int("keys", kDefaultKeys);
+  int iterations = options.Int("iterations", kDefaultIterations);
+  if (path.empty())
+    return options.Usage();
+
+  std::string db_path = path + "/.app_db_statement_benchmark.db";
+  remove(db_path.c_str());
+  sqlite3* db;
+  if (sqlite3_open(db_path.c_str(), &db) != SQLITE_OK ||
+      sqlite3_exec(db, kCreateQuery, NULL, NULL, NULL) != SQLITE_OK) {
+    fprintf(stderr, "Fail to create %s\n", db_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> keys;
+  for (int i = 0; i < key_count; ++i)
+    keys.push_back(KeyName(i));
+
+  // The first run fills the table for the reads.
+  bool success =
+      Run(db, "set", kSetFormat, kSetQuery, keys, iterations) &&
+      Run(db, "has", kHasFormat, kHasQuery, keys, iterations) &&
+      Run(db, "get", kGetFormat, kGetQuery, keys, iterations);
+
+  sqlite3_close(db);
+  remove(db_path.c_str());
+  if (!success) {
+    fprintf(stderr, "Statement failed\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
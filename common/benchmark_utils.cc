@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <sstream>
+
+#include "common/command_line.h"
+
+namespace common {
+namespace benchmark {
+
+Options::Options(int argc, char* argv[]) {
+  CommandLine::Init(argc, argv);
+  cmd_ = CommandLine::ForCurrentProcess();
+  usage_ = "Usage: " + cmd_->program();
+}
+
+std::string Options::Required(const std::string& name,
+                              const std::string& placeholder) {
+  AddUsage(name, placeholder, true);
+  return cmd_->GetOptionValue(name);
+}
+
+std::string Options::String(const std::string& name,
+                            const std::string& default_value) {
+  AddUsage(name, default_value.empty() ? "<" + name + ">" : default_value,
+           false);
+  std::string value = cmd_->GetOptionValue(name);
+  return value.empty() ? default_value : value;
+}
+
+int Options::Int(const std::string& name, int default_value) {
+  std::ostringstream usage;
+  usage << default_value;
+  AddUsage(name, usage.str(), false);
+  std::string value = cmd_->GetOptionValue(name);
+  if (value.empty())
+    return default_value;
+  int result = atoi(value.c_str());
+  return result > 0 ? result : default_value;
+}
+
+std::vector<std::string> Options::List(const std::string& name,
+                                       const std::string& default_value) {
+  return Split(String(name, default_value), ',');
+}
+
+std::vector<int> Options::IntList(const std::string& name,
+                                  const std::string& default_value) {
+  std::vector<int> result;
+  for (auto& item : List(name, default_value)) {
+    int value = atoi(item.c_str());
+    if (value > 0)
+      result.push_back(value);
+  }
+  return result;
+}
+
+int Options::Usage() const {
+  fprintf(stderr, "%s\n", usage_.c_str());
+  return EXIT_FAILURE;
+}
+
+void Options::AddUsage(const std::string& name, const std::string& value,
+                       bool required) {
+  std::string option = "--" + name + "=" + value;
+  usage_ += required ? " " + option : " [" + option + "]";
+}
+
+double Now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+std::vector<std::string> Split(const std::string& str, char separator) {
+  std::vector<std::string> result;
+  std::istringstream stream(str);
+  std::string item;
+  while (std::getline(stream, item, separator)) {
+    if (!item.empty())
+      result.push_back(item);
+  }
+  return result;
+}
+
+double PerItem(double seconds, double items, double scale) {
+  return items > 0 ? seconds * scale / items : 0;
+}
+
+void PrintResult(const picojson::object& result) {
+  printf("%s\n", picojson::value(result).serialize().c_str());
+  fflush(stdout);
+}
+
+int ExitStatus(int mismatches) {
+  if (mismatches == 0)
+    return EXIT_SUCCESS;
+  fprintf(stderr, "%d mismatches\n", mismatches);
+  return EXIT_FAILURE;
+}
+
+}  // namespace benchmark
+}  // namespace common
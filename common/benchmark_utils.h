@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_BENCHMARK_UTILS_H_
+#define XWALK_COMMON_BENCHMARK_UTILS_H_
+
+#include <string>
+#include <vector>
+
+#include "common/picojson.h"
+
+namespace common {
+
+class CommandLine;
+
+// Helpers shared by the xwalk_*_benchmark executables, which are only built
+// with -Dbuild_benchmarks=1.
+//
+// A benchmark takes --name=value options, and prints its usage when a
+// required one is missing. Every run prints one JSON object per line to
+// stdout, with the parameters of the run and what it measured, e.g.
+//   {"matcher":"compiled","model":"warp","rules":500,"ns_per_match":...}
+// Benchmarks that compare an implementation with the one it replaced also
+// check that both give the same results, and exit with a failure status if
+// they ever differ.
+namespace benchmark {
+
+// The options of a benchmark. Reading an option adds it to the usage.
+class Options {
+ public:
+  Options(int argc, char* argv[]);
+
+  // Value of --|name|, empty if it is missing. |placeholder| stands for it
+  // in the usage.
+  std::string Required(const std::string& name,
+                       const std::string& placeholder);
+  // Value of --|name|, or |default_value| if it is missing.
+  std::string String(const std::string& name,
+                     const std::string& default_value);
+  // Positive integer value of --|name|, or |default_value| if it is missing
+  // or invalid.
+  int Int(const std::string& name, int default_value);
+  // Non-empty items of the comma separated --|name|, or of |default_value|
+  // if it is missing.
+  std::vector<std::string> List(const std::string& name,
+                                const std::string& default_value);
+  // Positive integers of the comma separated --|name|, or of
+  // |default_value| if it is missing.
+  std::vector<int> IntList(const std::string& name,
+                           const std::string& default_value);
+
+  // Prints the usage of the options read so far to stderr. Returns the exit
+  // status for main().
+  int Usage() const;
+
+ private:
+  void AddUsage(const std::string& name, const std::string& value,
+                bool required);
+
+  CommandLine* cmd_;
+  std::string usage_;
+};
+
+// Monotonic time in seconds.
+double Now();
+
+// Non-empty items of |str| separated by |separator|.
+std::vector<std::string> Split(const std::string& str, char separator);
+
+// Nanoseconds, microseconds, ... per item, 0 if there were none.
+double PerItem(double seconds, double items, double scale);
+
+// Prints |result| as one JSON line on stdout.
+void PrintResult(const picojson::object& result);
+
+// Exit status for main() of a benchmark whose results differed from the
+// expected ones |mismatches| times.
+int ExitStatus(int mismatches);
+
+}  // namespace benchmark
+}  // namespace common
+
+#endif  // XWALK_COMMON_BENCHMARK_UTILS_H_
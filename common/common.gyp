@@ -18,15 +18,30 @@
         'string_utils.h',
         'string_utils.cc',
         'logger.h',
+        'mime_table.h',
+        'mime_table.cc',
+        'lru_cache.h',
+        'sharded_lru_cache.h',
+        'mutex.h',
         'picojson.h',
         'profiler.h',
         'profiler.cc',
         'url.h',
         'url.cc',
+        'url_view.h',
+        'url_view.cc',
+        'access_matcher.h',
+        'access_matcher.cc',
         'app_control.h',
+        'app_control_matcher.h',
+        'app_control_matcher.cc',
         'app_control.cc',
         'app_db.h',
         'app_db.cc',
+        'app_db_log.h',
+        'app_db_log.cc',
+        'app_db_preference.h',
+        'app_db_preference.cc',
         'app_db_sqlite.h',
         'application_data.h',
         'application_data.cc',
@@ -34,11 +49,35 @@
         'locale_manager.cc',
         'resource_manager.h',
         'resource_manager.cc',
+        'resource_prefetcher.h',
+        'resource_prefetcher.cc',
+      ],
+      'actions': [
+        {
+          'action_name': 'generate_mime_table',
+          'inputs': [
+            '../tools/generate_mime_table.py',
+            '<(mime_globs)',
+          ],
+          'outputs': [
+            '<(SHARED_INTERMEDIATE_DIR)/mime_table_data.cc',
+          ],
+          'process_outputs_as_sources': 1,
+          'action': [
+            'python',
+            '../tools/generate_mime_table.py',
+            '<(mime_globs)',
+            '<@(_outputs)',
+          ],
+          'message': 'Generating MIME table from <(mime_globs)',
+        },
       ],
       'cflags': [
         '-fvisibility=default',
       ],
       'variables': {
+        # globs of the shared-mime-info database
+        'mime_globs%': '/usr/share/mime/globs2',
         'packages': [
           'appsvc',
           'aul',
@@ -67,6 +106,107 @@
           ],
         },
       },
-    },
+    }
+  ],
+  'conditions': [
+    # The benchmarks aren't part of the package, build them with
+    # -Dbuild_benchmarks=1.
+    ['build_benchmarks==1', {
+      'targets': [
+        {
+          'target_name': 'xwalk_benchmark_utils',
+          'type': 'static_library',
+          'dependencies': [
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'benchmark_utils.h',
+            'benchmark_utils.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_appdb_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'app_db_benchmark.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_app_db_statement_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'app_db_statement_benchmark.cc',
+          ],
+          'variables': {
+            'packages': [
+              'sqlite3',
+            ],
+          },
+        },
+        {
+          'target_name': 'xwalk_access_matcher_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'access_matcher_benchmark.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_app_control_matcher_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'app_control_matcher_benchmark.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_decrypt_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'decrypt_benchmark.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_resource_manager_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'resource_manager_benchmark.cc',
+          ],
+        },
+        {
+          'target_name': 'xwalk_url_view_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            'xwalk_benchmark_utils',
+            'xwalk_tizen_common',
+          ],
+          'sources': [
+            'url_view_benchmark.cc',
+          ],
+        },
+      ],
+    }],
   ],
 }
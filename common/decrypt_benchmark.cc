@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Measures DecryptResource() of an installed encrypted widget, once with the
+// decrypted resource cache disabled and once with it enabled.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "common/application_data.h"
+#include "common/benchmark_utils.h"
+#include "common/locale_manager.h"
+#include "common/picojson.h"
+#include "common/resource_manager.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const int kDefaultIterations = 100;
+const int kDefaultBudget = 8 * 1024 * 1024;
+
+void Run(common::ResourceManager* resource_manager, const std::string& cache,
+         const std::string& base_path, const std::string& file,
+         int iterations) {
+  std::string path = "file://" + base_path + file;
+  size_t bytes = 0;
+  double start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i)
+    bytes = resource_manager->DecryptResource(path).length();
+  double seconds = benchmark::Now() - start;
+
+  picojson::object json;
+  json["cache"] = picojson::value(cache);
+  json["file"] = picojson::value(file);
+  json["bytes"] = picojson::value(static_cast<double>(bytes));
+  json["calls"] = picojson::value(static_cast<double>(iterations));
+  json["seconds"] = picojson::value(seconds);
+  json["us_per_call"] =
+      picojson::value(benchmark::PerItem(seconds, iterations, 1e6));
+  benchmark::PrintResult(json);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  std::string appid = options.Required("appid", "<app id>");
+  std::vector<std::string> files = benchmark::Split(
+      options.Required("files", "<file>[,<file>...]"), ',');
+  int iterations = options.Int("iterations", kDefaultIterations);
+  int budget = options.Int("budget", kDefaultBudget);
+  if (appid.empty() || files.empty())
+    return options.Usage();
+
+  common::ApplicationData app_data(appid);
+  if (!app_data.LoadManifestData()) {
+    fprintf(stderr, "Fail to load the manifest of %s\n", appid.c_str());
+    return EXIT_FAILURE;
+  }
+  common::LocaleManager locale_manager;
+  common::ResourceManager resource_manager(&app_data, &locale_manager);
+  std::string base_path = app_data.application_path();
+  if (!base_path.empty() && base_path[base_path.length() - 1] != '/')
+    base_path += "/";
+
+  for (auto& file : files) {
+    resource_manager.set_decrypted_cache_budget(0);
+    Run(&resource_manager, "cold", base_path, file, iterations);
+    resource_manager.set_decrypted_cache_budget(budget);
+    // the first call fills the cache
+    resource_manager.DecryptResource("file://" + base_path + file);
+    Run(&resource_manager, "warm", base_path, file, iterations);
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,7 @@
 
 #include "common/locale_manager.h"
 
+#include <glib.h>
 #include <system_settings.h>
 
 #include <algorithm>
@@ -42,7 +43,8 @@ std::string localeToBCP47LangTag(
 }  // namespace
 
 
-LocaleManager::LocaleManager() {
+LocaleManager::LocaleManager()
+    : locale_version_(0) {
   UpdateSystemLocale();
 }
 
@@ -64,6 +66,7 @@ void LocaleManager::EnableAutoUpdate(bool enable) {
 }
 
 void LocaleManager::SetDefaultLocale(const std::string& locale) {
+  AutoLock lock(&mutex_);
   if (!default_locale_.empty() && system_locales_.size() > 0 &&
        system_locales_.back() == default_locale_) {
     system_locales_.pop_back();
@@ -72,6 +75,7 @@ void LocaleManager::SetDefaultLocale(const std::string& locale) {
   if (!default_locale_.empty()) {
     system_locales_.push_back(locale);
   }
+  g_atomic_int_inc(&locale_version_);
 }
 
 void LocaleManager::UpdateSystemLocale() {
@@ -90,6 +94,7 @@ void LocaleManager::UpdateSystemLocale() {
     return;
   }
 
+  AutoLock lock(&mutex_);
   system_locales_.clear();
   while (true) {
     LOGGER(DEBUG) << "Processing language description: " << lang;
@@ -110,6 +115,17 @@ void LocaleManager::UpdateSystemLocale() {
   if (!default_locale_.empty()) {
     system_locales_.push_back(default_locale_);
   }
+  g_atomic_int_inc(&locale_version_);
+}
+
+int LocaleManager::locale_version() const {
+  return g_atomic_int_get(&locale_version_);
+}
+
+int LocaleManager::GetSystemLocales(std::list<std::string>* locales) const {
+  AutoLock lock(&mutex_);
+  *locales = system_locales_;
+  return locale_version_;
 }
 
 std::string LocaleManager::GetLocalizedString(const StringMap& strmap) {
@@ -21,6 +21,8 @@
 #include <map>
 #include <string>
 
+#include "common/mutex.h"
+
 namespace common {
 
 class LocaleManager {
@@ -32,14 +34,22 @@ class LocaleManager {
   void SetDefaultLocale(const std::string& locale);
   void EnableAutoUpdate(bool enable);
   void UpdateSystemLocale();
+  // The locales only change on the thread that calls SetDefaultLocale() and
+  // UpdateSystemLocale(), other threads use GetSystemLocales().
   const std::list<std::string>& system_locales() const
     { return system_locales_; }
+  // Changes whenever system_locales() changes, reading it takes no lock.
+  int locale_version() const;
+  // Copies system_locales() and returns their locale_version().
+  int GetSystemLocales(std::list<std::string>* locales) const;
 
   std::string GetLocalizedString(const StringMap& strmap);
 
  private:
   std::string default_locale_;
   std::list<std::string> system_locales_;
+  int locale_version_;
+  mutable Mutex mutex_;
 };
 
 }  // namespace common
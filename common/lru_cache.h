@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_LRU_CACHE_H_
+#define XWALK_COMMON_LRU_CACHE_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace common {
+
+struct CacheStatistics {
+  size_t hits;
+  size_t misses;
+  // number of entries
+  size_t size;
+  // sum of the entry costs, and its limit
+  size_t cost;
+  size_t capacity;
+};
+
+// Hash map with a limited total cost, which is the number of entries unless
+// Put() is given other costs. Adding an entry evicts the least recently used
+// ones until it fits.
+template <typename Key, typename Value, typename Hash = std::hash<Key> >
+class LRUCache {
+ public:
+  explicit LRUCache(size_t capacity)
+      : capacity_(capacity), cost_(0), hits_(0), misses_(0) {}
+
+  // Returns NULL if |key| is not cached. The pointer is valid until the
+  // next Put(), Remove() or Clear().
+  const Value* Get(const Key& key) {
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+      ++misses_;
+      return NULL;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return &found->second->value;
+  }
+
+  // An entry costing more than the whole capacity is not cached.
+  void Put(const Key& key, const Value& value, size_t cost = 1) {
+    Remove(key);
+    if (cost > capacity_)
+      return;
+    Evict(capacity_ - cost);
+    Entry entry = {key, value, cost};
+    entries_.push_front(entry);
+    index_[key] = entries_.begin();
+    cost_ += cost;
+  }
+
+  void Remove(const Key& key) {
+    auto found = index_.find(key);
+    if (found == index_.end())
+      return;
+    cost_ -= found->second->cost;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+
+  void Clear() {
+    index_.clear();
+    entries_.clear();
+    cost_ = 0;
+  }
+
+  void set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    Evict(capacity_);
+  }
+
+  CacheStatistics statistics() const {
+    CacheStatistics stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.size = index_.size();
+    stats.cost = cost_;
+    stats.capacity = capacity_;
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+    size_t cost;
+  };
+  typedef std::list<Entry> EntryList;
+
+  // Drops the least recently used entries until the cost is at most |cost|.
+  void Evict(size_t cost) {
+    while (cost_ > cost) {
+      cost_ -= entries_.back().cost;
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+  }
+
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<Key, typename EntryList::iterator, Hash> index_;
+  size_t capacity_;
+  size_t cost_;
+  size_t hits_;
+  size_t misses_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_LRU_CACHE_H_
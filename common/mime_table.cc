@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/mime_table.h"
+
+#include <ctype.h>
+#include <string.h>
+
+namespace common {
+
+namespace {
+
+// The longest extension in the table is far shorter.
+const size_t kMaxExtensionLength = 32;
+
+const char* FindExtension(const char* extension) {
+  size_t low = 0;
+  size_t high = kMimeTableSize;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    int compare = strcmp(kMimeTable[middle].extension, extension);
+    if (compare == 0)
+      return kMimeTable[middle].mime_type;
+    if (compare < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return NULL;
+}
+
+}  // namespace
+
+const char* GetMimeTypeFromTable(const char* path, size_t length) {
+  size_t name = length;
+  while (name > 0 && path[name - 1] != '/')
+    --name;
+
+  for (size_t dot = name; dot < length; ++dot) {
+    if (path[dot] != '.')
+      continue;
+    size_t extension_length = length - dot - 1;
+    if (extension_length == 0 || extension_length > kMaxExtensionLength)
+      continue;
+    char extension[kMaxExtensionLength + 1];
+    for (size_t i = 0; i < extension_length; ++i)
+      extension[i] = tolower(static_cast<unsigned char>(path[dot + 1 + i]));
+    extension[extension_length] = '\0';
+    const char* mime_type = FindExtension(extension);
+    if (mime_type != NULL)
+      return mime_type;
+  }
+  return NULL;
+}
+
+}  // namespace common
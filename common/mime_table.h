@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_MIME_TABLE_H_
+#define XWALK_COMMON_MIME_TABLE_H_
+
+#include <stddef.h>
+
+namespace common {
+
+struct MimeTableEntry {
+  const char* extension;
+  const char* mime_type;
+};
+
+// Lower case file extensions without the leading dot and their MIME types,
+// sorted by extension. Generated at build time by
+// tools/generate_mime_table.py from the shared-mime-info globs, leaving out
+// the extensions whose type depends on the content.
+extern const MimeTableEntry kMimeTable[];
+extern const size_t kMimeTableSize;
+
+// Returns the MIME type of the file name at the end of |path|, or NULL if
+// its extension is not in the table. The longest extension wins, so
+// "a.tar.gz" is looked up as "tar.gz" before "gz".
+const char* GetMimeTypeFromTable(const char* path, size_t length);
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_MIME_TABLE_H_
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_MUTEX_H_
+#define XWALK_COMMON_MUTEX_H_
+
+#include <glib.h>
+
+namespace common {
+
+class Mutex {
+ public:
+  Mutex() { g_mutex_init(&mutex_); }
+  ~Mutex() { g_mutex_clear(&mutex_); }
+
+  Mutex(const Mutex&) = delete;
+  Mutex& operator=(const Mutex&) = delete;
+
+  void Lock() { g_mutex_lock(&mutex_); }
+  void Unlock() { g_mutex_unlock(&mutex_); }
+
+ private:
+  GMutex mutex_;
+};
+
+// Holds |mutex| for its lifetime, or until Release() is called.
+class AutoLock {
+ public:
+  explicit AutoLock(Mutex* mutex) : mutex_(mutex) { mutex_->Lock(); }
+  ~AutoLock() { Release(); }
+
+  void Release() {
+    if (mutex_) {
+      mutex_->Unlock();
+      mutex_ = NULL;
+    }
+  }
+
+  AutoLock(const AutoLock&) = delete;
+  AutoLock& operator=(const AutoLock&) = delete;
+
+ private:
+  Mutex* mutex_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_MUTEX_H_
@@ -17,9 +17,16 @@
 #include "common/resource_manager.h"
 
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <aul.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <glib.h>
 #include <pkgmgr-info.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <web_app_enc.h>
 
@@ -27,7 +34,6 @@
 #include <functional>
 #include <memory>
 #include <set>
-#include <sstream>
 #include <vector>
 
 #include "common/application_data.h"
@@ -35,8 +41,9 @@
 #include "common/file_utils.h"
 #include "common/locale_manager.h"
 #include "common/logger.h"
+#include "common/mime_table.h"
 #include "common/string_utils.h"
-#include "common/url.h"
+#include "common/url_view.h"
 
 using wgt::parse::AppControlInfo;
 
@@ -44,8 +51,6 @@ namespace common {
 
 namespace {
 
-typedef std::vector<AppControlInfo> AppControlList;
-
 // Scheme type
 const char* kSchemeTypeApp = "app://";
 const char* kSchemeTypeFile = "file://";
@@ -71,69 +76,39 @@ const char* kDefaultEncoding = "UTF-8";
 const std::set<std::string> kEncryptedFileExtensions{
     ".html", ".htm", ".css", ".js"};
 
-static std::string GetMimeFromUri(const std::string& uri) {
-  // checking passed uri is local file
-  std::string file_uri_case(kSchemeTypeFile);
-  int ret = AUL_R_EINVAL;
-  char mimetype[128] = {0, };
-  size_t pos = std::string::npos;
-  if (utils::StartsWith(uri, file_uri_case)) {
-    // case 1. uri = file:///xxxx
-    ret = aul_get_mime_from_file(uri.substr(pos+file_uri_case.length()).c_str(),
-                                 mimetype, sizeof(mimetype));
-  } else if (utils::StartsWith(uri, "/")) {
-    // case 2. uri = /xxxx
-    ret = aul_get_mime_from_file(uri.c_str(),
-                                 mimetype, sizeof(mimetype));
-  }
-
-  if (ret == AUL_R_OK) {
-    return std::string(mimetype);
-  } else {
-    return std::string();
-  }
+// The locale index has one bit per locale directory.
+const size_t kMaxIndexedLocales = 64;
+// Guards the locale index against symbolic link loops.
+const int kMaxLocaleIndexDepth = 16;
+
+// Cache capacities, in entries, and the number of locks they are split by.
+const size_t kFileExistedCacheSize = 1024;
+const size_t kLocaleCacheSize = 512;
+const size_t kAccessCacheSize = 256;
+const size_t kMimeCacheSize = 64;
+const size_t kCacheShards = 8;
+// Default budget of the decrypted resource cache, in bytes.
+const size_t kDecryptedCacheBudget = 8 * 1024 * 1024;
+
+static bool IsDirectory(const std::string& path) {
+  struct stat buf;
+  return stat(path.c_str(), &buf) == 0 && S_ISDIR(buf.st_mode);
 }
 
-static bool CompareMime(const std::string& info_mime,
-                        const std::string& request_mime) {
-  // suppose that these mimetypes are valid expressions ('type'/'sub-type')
-  if (info_mime == "*" || info_mime == "*/*")
-    return true;
-
-  if (request_mime.empty())
-    return info_mime.empty();
-
-  std::string info_type;
-  std::string info_sub;
-  std::string request_type;
-  std::string request_sub;
-  if (!(utils::SplitString(info_mime, &info_type, &info_sub, '/') &&
-        utils::SplitString(request_mime, &request_type, &request_sub, '/')))
+// The locale index only has paths in their plain form, anything the
+// filesystem would resolve differently is looked up on disk.
+static bool IsIndexablePath(const std::string& path) {
+  if (path.empty() || path[0] == '/')
     return false;
-
-  return info_type == request_type &&
-         (info_sub == "*") ? true : (info_sub == request_sub);
-}
-
-static bool CompareUri(const std::string& info_uri,
-                       const std::string& request_uri) {
-  if (request_uri.empty())
-    return info_uri.empty();
-
-  std::string info_scheme = utils::SchemeName(info_uri);
-
-  // if has only scheme or scheme+star. ex) http, http://, http://*
-  if (!info_scheme.empty() &&
-      (info_uri == info_scheme || utils::EndsWith(info_uri, "://")
-        || utils::EndsWith(info_uri, "://*"))) {
-    return utils::SchemeName(request_uri) == info_scheme;
-  }
-
-  if (utils::EndsWith(info_uri, "*")) {
-    return utils::StartsWith(request_uri, info_uri.substr(0,
-                                                          info_uri.length()-1));
-  } else {
-    return request_uri == info_uri;
+  size_t start = 0;
+  while (true) {
+    size_t end = path.find('/', start);
+    std::string segment = path.substr(start, end - start);
+    if (segment.empty() || segment == "." || segment == "..")
+      return false;
+    if (end == std::string::npos)
+      return true;
+    start = end + 1;
   }
 }
 
@@ -182,7 +157,19 @@ bool ResourceManager::Resource::operator==(const Resource& res) {
 
 ResourceManager::ResourceManager(ApplicationData* application_data,
                                  LocaleManager* locale_manager)
-    : application_data_(application_data), locale_manager_(locale_manager) {
+    : file_existed_cache_(kFileExistedCacheSize, kCacheShards),
+      locale_cache_(kLocaleCacheSize, kCacheShards),
+      warp_cache_(kAccessCacheSize, kCacheShards),
+      navigation_cache_(kAccessCacheSize, kCacheShards),
+      mime_cache_(kMimeCacheSize, kCacheShards),
+      // one shard, so that a resource may take the whole budget
+      decrypted_cache_(kDecryptedCacheBudget, 1),
+      app_type_checked_(false),
+      app_type_(WAE_DOWNLOADED_NORMAL_APP),
+      locale_state_(NULL),
+      locale_generation_(0),
+      application_data_(application_data),
+      locale_manager_(locale_manager) {
   if (application_data != NULL) {
     appid_ = application_data->tizen_application_info()->id();
     if (application_data->csp_info() != NULL ||
@@ -192,6 +179,22 @@ ResourceManager::ResourceManager(ApplicationData* application_data,
     } else {
       security_model_version_ = 1;
     }
+
+    auto app_controls = application_data->app_control_info_list();
+    if (app_controls.get() != NULL) {
+      for (auto& info : app_controls->controls)
+        app_control_matcher_.Add(info.operation(), info.mime(), info.uri());
+    }
+    auto warp = application_data->warp_info();
+    if (warp.get() != NULL) {
+      for (auto& allow : warp->access_map())
+        warp_matcher_.AddWarpRule(allow.first, allow.second);
+    }
+    auto allow = application_data->allowed_navigation_info();
+    if (allow.get() != NULL) {
+      for (auto& allow_domain : allow->GetAllowedDomains())
+        navigation_matcher_.AddNavigationRule(allow_domain);
+    }
   }
 }
 
@@ -272,32 +275,33 @@ std::unique_ptr<ResourceManager::Resource> ResourceManager::GetStartResource(
     return GetDefaultResource();
   }
 
-  auto app_control_list =
-    application_data_->app_control_info_list()->controls;
-
-  AppControlList::const_iterator iter = std::find_if(
-    app_control_list.begin(), app_control_list.end(),
-    [&operation, &uri, &mime](AppControlInfo& info) -> bool {
-      return (info.operation() == operation)
-        && CompareMime(info.mime(), mime) && CompareUri(info.uri(), uri); });
-
-  if (iter != app_control_list.end()) {
-    return GetMatchedResource(*iter);
+  int matched = app_control_matcher_.Match(operation, mime, uri);
+  if (matched >= 0) {
+    return GetMatchedResource(
+        application_data_->app_control_info_list()->controls[matched]);
   } else {
-  return GetDefaultResource();
+    return GetDefaultResource();
   }
 }
 
 std::string ResourceManager::GetLocalizedPath(const std::string& origin) {
+  const LocaleState* state = GetLocaleState();
+  std::pair<int, std::string> cached;
+  if (locale_cache_.Get(origin, &cached) &&
+      cached.first == state->generation) {
+    return cached.second;
+  }
+  std::string result = ResolveLocalizedPath(*state, origin);
+  locale_cache_.Put(origin, std::make_pair(state->generation, result));
+  return result;
+}
+
+std::string ResourceManager::ResolveLocalizedPath(const LocaleState& state,
+                                                  const std::string& origin) {
   std::string file_scheme = std::string() + kSchemeTypeFile + "/";
   std::string app_scheme = std::string() + kSchemeTypeApp;
   std::string locale_path = "locales/";
-  auto find = locale_cache_.find(origin);
-  if (find != locale_cache_.end()) {
-    return find->second;
-  }
-  std::string& result = locale_cache_[origin];
-  result = origin;
+  std::string result = origin;
   std::string url = origin;
 
   std::string suffix;
@@ -334,22 +338,35 @@ std::string ResourceManager::GetLocalizedPath(const std::string& origin) {
   }
 
   std::string file_path = utils::UrlDecode(RemoveLocalePath(url));
-  for (auto& locales : locale_manager_->system_locales()) {
-    // check ../locales/
-    std::string app_locale_path = resource_base_path_ + locale_path;
-    if (!Exists(app_locale_path)) {
-      break;
+  if (state.index->usable && IsIndexablePath(file_path)) {
+    auto indexed = state.index->paths.find(file_path);
+    if (indexed != state.index->paths.end()) {
+      for (auto& locale : state.order) {
+        if (indexed->second & locale.second) {
+          result = "file://" + resource_base_path_ + locale_path +
+                   locale.first + "/" + file_path + suffix;
+          return result;
+        }
+      }
     }
+  } else {
+    for (auto& locales : state.locales) {
+      // check ../locales/
+      std::string app_locale_path = resource_base_path_ + locale_path;
+      if (!Exists(app_locale_path)) {
+        break;
+      }
 
-    // check locale path ../locales/en_us/
-    std::string app_localized_path = app_locale_path + locales + "/";
-    if (!Exists(app_localized_path)) {
-      continue;
-    }
-    std::string resource_path = app_localized_path + file_path;
-    if (Exists(resource_path)) {
-      result = "file://" + resource_path + suffix;
-      return result;
+      // check locale path ../locales/en_us/
+      std::string app_localized_path = app_locale_path + locales + "/";
+      if (!Exists(app_localized_path)) {
+        continue;
+      }
+      std::string resource_path = app_localized_path + file_path;
+      if (Exists(resource_path)) {
+        result = "file://" + resource_path + suffix;
+        return result;
+      }
     }
   }
 
@@ -391,17 +408,153 @@ void ResourceManager::set_base_resource_path(const std::string& path) {
   if (resource_base_path_[resource_base_path_.length()-1] != '/') {
     resource_base_path_ += "/";
   }
+  AutoLock lock(&locale_mutex_);
+  locale_index_.reset();
+  g_atomic_pointer_set(&locale_state_, NULL);
+  locale_cache_.Clear();
+}
+
+const ResourceManager::LocaleState* ResourceManager::GetLocaleState() {
+  const LocaleState* current =
+      static_cast<const LocaleState*>(g_atomic_pointer_get(&locale_state_));
+  if (current && current->version == locale_manager_->locale_version())
+    return current;
+
+  AutoLock lock(&locale_mutex_);
+  // Another thread may have rebuilt it while this one waited.
+  current = locale_state_;
+  if (current && current->version == locale_manager_->locale_version())
+    return current;
+
+  if (!locale_index_)
+    locale_index_.reset(BuildLocaleIndex(resource_base_path_));
+  LocaleState* state = new LocaleState;
+  locale_states_.push_back(std::unique_ptr<const LocaleState>(state));
+  state->version = locale_manager_->GetSystemLocales(&state->locales);
+  state->generation = ++locale_generation_;
+  state->index = locale_index_;
+  for (auto& locale : state->locales) {
+    auto bit = locale_index_->bits.find(locale);
+    if (bit != locale_index_->bits.end())
+      state->order.push_back(std::make_pair(locale, bit->second));
+  }
+  g_atomic_pointer_set(&locale_state_, state);
+
+  // Localized paths resolved for the previous locales are stale.
+  locale_cache_.Clear();
+  return state;
+}
+
+// static
+ResourceManager::LocaleIndex* ResourceManager::BuildLocaleIndex(
+    const std::string& base_path) {
+  LocaleIndex* index = new LocaleIndex;
+  index->usable = true;
+
+  std::string locales_dir = base_path + "locales/";
+  DIR* dir = opendir(locales_dir.c_str());
+  if (dir == NULL)
+    return index;
+  std::vector<std::string> locales;
+  struct dirent* entry;
+  while ((entry = readdir(dir)) != NULL) {
+    std::string name(entry->d_name);
+    if (name != "." && name != ".." && IsDirectory(locales_dir + name))
+      locales.push_back(name);
+  }
+  closedir(dir);
+
+  if (locales.size() > kMaxIndexedLocales) {
+    LOGGER(WARN) << "Too many locales to index : " << locales.size();
+    index->usable = false;
+    return index;
+  }
+  for (size_t i = 0; i < locales.size(); ++i) {
+    uint64_t bit = static_cast<uint64_t>(1) << i;
+    index->bits[locales[i]] = bit;
+    IndexLocaleDirectory(locales_dir + locales[i] + "/", std::string(), bit,
+                         0, index);
+  }
+  return index;
+}
+
+// static
+void ResourceManager::IndexLocaleDirectory(const std::string& dir_path,
+                                           const std::string& relative_path,
+                                           uint64_t locale_bit,
+                                           int depth,
+                                           LocaleIndex* index) {
+  if (depth > kMaxLocaleIndexDepth)
+    return;
+  DIR* dir = opendir(dir_path.c_str());
+  if (dir == NULL)
+    return;
+  struct dirent* entry;
+  while ((entry = readdir(dir)) != NULL) {
+    std::string name(entry->d_name);
+    if (name == "." || name == "..")
+      continue;
+    std::string relative = relative_path + name;
+    index->paths[relative] |= locale_bit;
+    std::string path = dir_path + name;
+    if (IsDirectory(path)) {
+      IndexLocaleDirectory(path + "/", relative + "/", locale_bit, depth + 1,
+                           index);
+    }
+  }
+  closedir(dir);
 }
 
 bool ResourceManager::Exists(const std::string& path) {
-  auto find = file_existed_cache_.find(path);
-  if (find != file_existed_cache_.end()) {
-    return find->second;
+  bool cached;
+  if (file_existed_cache_.Get(path, &cached)) {
+    return cached;
   }
-  bool ret = file_existed_cache_[path] = utils::Exists(path);
+  bool ret = utils::Exists(path);
+  file_existed_cache_.Put(path, ret);
   return ret;
 }
 
+std::string ResourceManager::GetMimeFromUri(const std::string& uri) {
+  // checking passed uri is local file
+  size_t path_start = 0;
+  if (utils::StartsWith(uri, kSchemeTypeFile)) {
+    // case 1. uri = file:///xxxx
+    path_start = strlen(kSchemeTypeFile);
+  } else if (!utils::StartsWith(uri, "/")) {
+    // case 2. uri = /xxxx
+    return std::string();
+  }
+
+  const char* mime_type = GetMimeTypeFromTable(uri.data() + path_start,
+                                               uri.length() - path_start);
+  if (mime_type != NULL)
+    return mime_type;
+
+  // the extension is unknown or ambiguous, aul sniffs the content
+  std::string path = uri.substr(path_start);
+  struct stat st;
+  bool found = stat(path.c_str(), &st) == 0;
+  int64_t mtime_ns = 0;
+  if (found) {
+    mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+               st.st_mtim.tv_nsec;
+    // A file replaced at the same path is sniffed again.
+    SniffedMime cached;
+    if (mime_cache_.Get(path, &cached) && cached.mtime_ns == mtime_ns &&
+        cached.size == st.st_size)
+      return cached.mime;
+  }
+  std::string result;
+  char mimetype[128] = {0, };
+  if (aul_get_mime_from_file(path.c_str(), mimetype, sizeof(mimetype)) ==
+      AUL_R_OK)
+    result = mimetype;
+  if (found)
+    mime_cache_.Put(path, SniffedMime{mtime_ns, st.st_size, result});
+  return result;
+}
+
 bool ResourceManager::AllowNavigation(const std::string& url) {
   if (security_model_version_ == 2)
     return CheckAllowNavigation(url);
@@ -414,6 +567,41 @@ bool ResourceManager::AllowedResource(const std::string& url) {
   return CheckWARP(url);
 }
 
+bool ResourceManager::OriginKey::operator==(const OriginKey& other) const {
+  return length == other.length && memcmp(data, other.data, length) == 0;
+}
+
+size_t ResourceManager::OriginKeyHash::operator()(
+    const OriginKey& key) const {
+  // FNV-1a
+  size_t hash = 2166136261u;
+  for (size_t i = 0; i < key.length; ++i) {
+    hash ^= static_cast<unsigned char>(key.data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// static
+bool ResourceManager::GetOrigin(const URLView& url, OriginKey* origin) {
+  const URLComponent& scheme = url.scheme();
+  const URLComponent& domain = url.domain();
+  // ":port" and the NUL take at most 13 bytes
+  if (scheme.length + domain.length + 3 + 13 > sizeof(origin->data))
+    return false;
+  char* out = origin->data;
+  for (size_t i = 0; i < scheme.length; ++i)
+    *out++ = tolower(scheme.data[i]);
+  memcpy(out, "://", 3);
+  out += 3;
+  memcpy(out, domain.data, domain.length);
+  out += domain.length;
+  out += snprintf(out, origin->data + sizeof(origin->data) - out, ":%d",
+                  url.port());
+  origin->length = out - origin->data;
+  return true;
+}
+
 bool ResourceManager::CheckWARP(const std::string& url) {
   // allow non-external resource
   if (!utils::StartsWith(url, kSchemeTypeHttp) &&
@@ -421,56 +609,23 @@ bool ResourceManager::CheckWARP(const std::string& url) {
     return true;
   }
 
-  auto warp = application_data_->warp_info();
-  if (warp.get() == NULL)
-    return false;
-
-  auto find = warp_cache_.find(url);
-  if (find != warp_cache_.end()) {
-    return find->second;
-  }
-
-  bool& result = warp_cache_[url];
-  result = true;
-
-  URL url_info(url);
+  URLView url_info(url);
 
   // if didn't have a scheme, it means local resource
   if (url_info.scheme().empty()) {
     return true;
   }
 
-  for (auto& allow : warp->access_map()) {
-    if (allow.first == "*") {
-      return true;
-    } else if (allow.first.empty()) {
-      continue;
-    }
-
-    URL allow_url(allow.first);
-
-    // should be match the scheme and port
-    if (allow_url.scheme() != url_info.scheme() ||
-        allow_url.port() != url_info.port()) {
-      continue;
-    }
-
-    // if domain alos was matched, allow resource
-    if (allow_url.domain() == url_info.domain()) {
-      return true;
-    } else if (allow.second) {
-      // if does not match domain, should be check sub domain
-
-      // filter : test.com , subdomain=true
-      // url : aaa.test.com
-      // check url was ends with ".test.com"
-      if (utils::EndsWith(url_info.domain(), "." + allow_url.domain())) {
-        return true;
-      }
-    }
+  OriginKey origin;
+  if (!GetOrigin(url_info, &origin))
+    return warp_matcher_.Match(url_info);
+  bool cached;
+  if (warp_cache_.Get(origin, &cached)) {
+    return cached;
   }
-
-  return result = false;
+  bool result = warp_matcher_.Match(url_info);
+  warp_cache_.Put(origin, result);
+  return result;
 }
 
 bool ResourceManager::CheckAllowNavigation(const std::string& url) {
@@ -480,74 +635,23 @@ bool ResourceManager::CheckAllowNavigation(const std::string& url) {
     return true;
   }
 
-  auto allow = application_data_->allowed_navigation_info();
-  if (allow.get() == NULL)
-    return false;
-
-  auto find = warp_cache_.find(url);
-  if (find != warp_cache_.end()) {
-    return find->second;
-  }
-
-  bool& result = warp_cache_[url];
-  result = true;
-
-  URL url_info(url);
+  URLView url_info(url);
 
   // if didn't have a scheme, it means local resource
   if (url_info.scheme().empty()) {
     return true;
   }
 
-  for (auto& allow_domain : allow->GetAllowedDomains()) {
-    URL a_domain_info(allow_domain);
-
-    // check wildcard *
-    if (a_domain_info.domain() == "*") {
-      return true;
-    }
-
-    bool prefix_wild = false;
-    bool suffix_wild = false;
-    std::string a_domain = a_domain_info.domain();
-    if (utils::StartsWith(a_domain, "*.")) {
-      prefix_wild = true;
-      // *.domain.com -> .domain.com
-      a_domain = a_domain.substr(1);
-    }
-    if (utils::EndsWith(a_domain, ".*")) {
-      suffix_wild = true;
-      // domain.* -> domain.
-      a_domain = a_domain.substr(0, a_domain.length() - 1);
-    }
-
-    if (!prefix_wild && !suffix_wild) {
-      // if no wildcard, should be exactly matched
-      if (url_info.domain() == a_domain) {
-        return true;
-      }
-    } else if (prefix_wild && !suffix_wild) {
-      // *.domain.com : it shoud be "domain.com" or end with ".domain.com"
-      if (url_info.domain() == a_domain.substr(1) ||
-          utils::EndsWith(url_info.domain(), a_domain)) {
-        return true;
-      }
-    } else if (!prefix_wild && suffix_wild) {
-      // www.sample.* : it should be starts with "www.sample."
-      if (utils::StartsWith(url_info.domain(), a_domain)) {
-        return true;
-      }
-    } else if (prefix_wild && suffix_wild) {
-      // *.sample.* : it should be starts with sample. or can find ".sample."
-      // in url
-      if (utils::StartsWith(url_info.domain(), a_domain.substr(1)) ||
-          std::string::npos != url_info.domain().find(a_domain)) {
-        return true;
-      }
-    }
+  OriginKey origin;
+  if (!GetOrigin(url_info, &origin))
+    return navigation_matcher_.Match(url_info);
+  bool cached;
+  if (navigation_cache_.Get(origin, &cached)) {
+    return cached;
   }
-
-  return result = false;
+  bool result = navigation_matcher_.Match(url_info);
+  navigation_cache_.Put(origin, result);
+  return result;
 }
 
 bool ResourceManager::IsEncrypted(const std::string& path) {
@@ -571,35 +675,48 @@ std::string ResourceManager::DecryptResource(const std::string& path) {
     src_path.erase(0, strlen(kSchemeTypeFile));
   }
 
-  FILE *src = fopen(src_path.c_str(), "rb");
-  if (!src) {
+  int src = open(src_path.c_str(), O_RDONLY);
+  if (src < 0) {
     LOGGER(ERROR) << "Cannot open file for decryption: " << src_path;
     return path;
   }
 
-  // Read filesize
-  fseek(src, 0, SEEK_END);
-  size_t src_len = ftell(src);
-  rewind(src);
+  // Map the source file instead of copying it, it is only read once
+  struct stat src_stat;
+  if (fstat(src, &src_stat) != 0 || src_stat.st_size <= 0) {
+    LOGGER(ERROR) << "Read error, file: " << src_path;
+    close(src);
+    return path;
+  }
+  int64_t mtime_ns = static_cast<int64_t>(src_stat.st_mtim.tv_sec) *
+                     1000000000 + src_stat.st_mtim.tv_nsec;
+  std::shared_ptr<const DecryptedResource> cached;
+  if (decrypted_cache_.Get(src_path, &cached)) {
+    if (cached->mtime_ns == mtime_ns && cached->size == src_stat.st_size) {
+      close(src);
+      return cached->data_url;
+    }
+    decrypted_cache_.Remove(src_path);
+  }
 
-  // Read buffer from the source file
-  std::unique_ptr<char> src_buf(new char[src_len]);
-  if (src_len != fread(src_buf.get(), sizeof(char), src_len, src)) {
+  size_t src_len = src_stat.st_size;
+  void* src_map = mmap(NULL, src_len, PROT_READ, MAP_PRIVATE, src, 0);
+  close(src);
+  if (src_map == MAP_FAILED) {
     LOGGER(ERROR) << "Read error, file: " << src_path;
-    fclose(src);
     return path;
   }
-  fclose(src);
+  std::unique_ptr<void, std::function<void(void*)> > src_buf(
+      src_map, [src_len](void* addr) { munmap(addr, src_len); });
 
   // checking web app type
-  static bool inited = false;
-  static bool is_global = false;
-  static bool is_preload = false;
-
   int ret;
   std::string pkg_id = application_data_->pkg_id();
-  if (!inited) {
-    inited = true;
+  AutoLock lock(&decrypt_mutex_);
+  if (!app_type_checked_) {
+    app_type_checked_ = true;
+    bool is_global = false;
+    bool is_preload = false;
     pkgmgrinfo_pkginfo_h handle;
     ret = pkgmgrinfo_pkginfo_get_usr_pkginfo(pkg_id.c_str(), getuid(), &handle);
     if (ret != PMINFO_R_OK) {
@@ -623,21 +740,20 @@ std::string ResourceManager::DecryptResource(const std::string& path) {
       }
       pkgmgrinfo_pkginfo_destroy_pkginfo(handle);
     }
+    if (is_global) {
+      app_type_ = WAE_DOWNLOADED_GLOBAL_APP;
+    } else if (is_preload) {
+      app_type_ = WAE_PRELOADED_APP;
+    }
   }
-
-  wae_app_type_e app_type = WAE_DOWNLOADED_NORMAL_APP;
-  if (is_global) {
-    app_type = WAE_DOWNLOADED_GLOBAL_APP;
-  } else if (is_preload) {
-    app_type = WAE_PRELOADED_APP;
-  }
+  wae_app_type_e app_type = static_cast<wae_app_type_e>(app_type_);
 
   // decrypt buffer with wae functions
   uint8_t* dst_buf = nullptr;
   size_t dst_len = 0;
   ret = wae_decrypt_web_application(pkg_id.c_str(),
                                     app_type,
-                                    reinterpret_cast<uint8_t*>(src_buf.get()),
+                                    static_cast<uint8_t*>(src_buf.get()),
                                     src_len,
                                     &dst_buf,
                                     &dst_len);
@@ -667,16 +783,33 @@ std::string ResourceManager::DecryptResource(const std::string& path) {
     }
     return path;
   }
+  lock.Release();
 
-  // change to data schem
-  std::stringstream dst_str;
+  src_buf.reset();
+
+  // change to data scheme, encoding into the url itself
   std::string content_type = GetMimeFromUri(path);
-  std::string encoded = utils::Base64Encode(dst_buf, dst_len);
-  dst_str << "data:" << content_type << ";base64," << encoded;
+  std::string data_url;
+  data_url.reserve(content_type.length() + 20 + (dst_len / 3 + 1) * 4 + 4);
+  data_url.append("data:").append(content_type).append(";base64,");
+  utils::AppendBase64(dst_buf, dst_len, &data_url);
 
   std::free(dst_buf);
 
-  return dst_str.str();
+  DecryptedResource* decrypted =
+      new DecryptedResource{mtime_ns, src_stat.st_size, data_url};
+  decrypted_cache_.Put(src_path,
+                       std::shared_ptr<const DecryptedResource>(decrypted),
+                       data_url.length());
+  return data_url;
+}
+
+void ResourceManager::set_decrypted_cache_budget(size_t bytes) {
+  decrypted_cache_.set_capacity(bytes);
+}
+
+void ResourceManager::ClearDecryptedCache() {
+  decrypted_cache_.Clear();
 }
 
 }  // namespace common
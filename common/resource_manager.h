@@ -17,9 +17,21 @@
 #ifndef XWALK_COMMON_RESOURCE_MANAGER_H_
 #define XWALK_COMMON_RESOURCE_MANAGER_H_
 
+#include <stdint.h>
+
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/access_matcher.h"
+#include "common/app_control_matcher.h"
+#include "common/lru_cache.h"
+#include "common/mutex.h"
+#include "common/sharded_lru_cache.h"
 
 namespace wgt {
 namespace parse {
@@ -33,6 +45,8 @@ class ApplicationData;
 class LocaleManager;
 class AppControl;
 
+// Everything but GetStartResource() and the setters may be called from
+// several threads at once.
 class ResourceManager {
  public:
   class Resource {
@@ -77,25 +91,140 @@ class ResourceManager {
 
   bool IsEncrypted(const std::string& url);
   std::string DecryptResource(const std::string& path);
+  // Decrypted resources are cached up to |bytes|, 0 disables the cache.
+  void set_decrypted_cache_budget(size_t bytes);
+  // Drops the decrypted resources, e.g. on low memory.
+  void ClearDecryptedCache();
 
+  // Not thread-safe, to be called before the other methods.
   void set_base_resource_path(const std::string& base_path);
 
+  CacheStatistics file_existed_cache_statistics() const {
+    return file_existed_cache_.statistics();
+  }
+  CacheStatistics locale_cache_statistics() const {
+    return locale_cache_.statistics();
+  }
+  CacheStatistics warp_cache_statistics() const {
+    return warp_cache_.statistics();
+  }
+  CacheStatistics navigation_cache_statistics() const {
+    return navigation_cache_.statistics();
+  }
+  CacheStatistics mime_cache_statistics() const {
+    return mime_cache_.statistics();
+  }
+  CacheStatistics decrypted_cache_statistics() const {
+    return decrypted_cache_.statistics();
+  }
+
  private:
+  // data: url of a decrypted file, valid while the file is unchanged.
+  struct DecryptedResource {
+    int64_t mtime_ns;
+    int64_t size;
+    std::string data_url;
+  };
+
+  // The MIME type aul sniffed from the content of a file, and the version
+  // of the file it was sniffed from.
+  struct SniffedMime {
+    int64_t mtime_ns;
+    int64_t size;
+    std::string mime;
+  };
+
+  struct LocaleIndex {
+    // Every file and directory under locales/, relative to its locale
+    // directory, with a bit set for each locale that has it.
+    std::unordered_map<std::string, uint64_t> paths;
+    std::map<std::string, uint64_t> bits;
+    bool usable;
+  };
+
+  // Never changed once built, a new one replaces it when the locales
+  // change. Replaced states live as long as the ResourceManager, so readers
+  // need no lock or reference.
+  struct LocaleState {
+    // locale_version() of the locales
+    int version;
+    int generation;
+    // system_locales() in order of preference
+    std::list<std::string> locales;
+    std::shared_ptr<const LocaleIndex> index;
+    // (locale, bit) of the locales that are in the index
+    std::vector<std::pair<std::string, uint64_t> > order;
+  };
+
+  // "scheme://host:port" of a url, stored inline so that looking up the
+  // access caches doesn't allocate.
+  struct OriginKey {
+    bool operator==(const OriginKey& other) const;
+
+    char data[64];
+    size_t length;
+  };
+  struct OriginKeyHash {
+    size_t operator()(const OriginKey& key) const;
+  };
+
   std::unique_ptr<Resource> GetMatchedResource(
     const wgt::parse::AppControlInfo&);
   std::unique_ptr<Resource> GetDefaultResource();
 
+  std::string GetMimeFromUri(const std::string& uri);
+
   // for localization
+  std::string ResolveLocalizedPath(const LocaleState& state,
+                                   const std::string& origin);
   bool Exists(const std::string& path);
+  const LocaleState* GetLocaleState();
+  static LocaleIndex* BuildLocaleIndex(const std::string& base_path);
+  static void IndexLocaleDirectory(const std::string& dir_path,
+                                   const std::string& relative_path,
+                                   uint64_t locale_bit,
+                                   int depth,
+                                   LocaleIndex* index);
+  // False if the origin of |url| is too long for an OriginKey.
+  static bool GetOrigin(const URLView& url, OriginKey* origin);
   bool CheckWARP(const std::string& url);
   bool CheckAllowNavigation(const std::string& url);
   std::string RemoveLocalePath(const std::string& path);
 
   std::string resource_base_path_;
   std::string appid_;
-  std::map<const std::string, bool> file_existed_cache_;
-  std::map<const std::string, std::string> locale_cache_;
-  std::map<const std::string, bool> warp_cache_;
+  ShardedLRUCache<std::string, bool> file_existed_cache_;
+  // Localized paths and the LocaleState generation they were resolved for.
+  ShardedLRUCache<std::string, std::pair<int, std::string> > locale_cache_;
+  // Access decisions only depend on the origin of the url, so these are
+  // keyed by it.
+  ShardedLRUCache<OriginKey, bool, OriginKeyHash> warp_cache_;
+  ShardedLRUCache<OriginKey, bool, OriginKeyHash> navigation_cache_;
+  // MIME types aul found for files the built-in table has no type for.
+  ShardedLRUCache<std::string, SniffedMime> mime_cache_;
+  // Compiled from the manifest, these match nothing if it has no rules.
+  AccessMatcher warp_matcher_;
+  AccessMatcher navigation_matcher_;
+  // Numbers the entries of app_control_info_list()
+  AppControlMatcher app_control_matcher_;
+  // Costs are the sizes of the data: urls, in bytes.
+  ShardedLRUCache<std::string, std::shared_ptr<const DecryptedResource> >
+      decrypted_cache_;
+  // Guards the app type, and decryption as libwebappenc is not known to be
+  // thread-safe.
+  Mutex decrypt_mutex_;
+  bool app_type_checked_;
+  int app_type_;
+
+  // Guards the members below when the locale state is rebuilt. The current
+  // state itself is published and read atomically.
+  Mutex locale_mutex_;
+  // Built once per resource path.
+  std::shared_ptr<const LocaleIndex> locale_index_;
+  const LocaleState* locale_state_;
+  // Owns every state built so far, they are few as locales rarely change.
+  std::vector<std::unique_ptr<const LocaleState> > locale_states_;
+  int locale_generation_;
 
   ApplicationData* application_data_;
   LocaleManager* locale_manager_;
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Calls GetLocalizedPath(), AllowNavigation() and AllowedResource() of an
+// installed application from several threads at once, while the main thread
+// keeps switching the default locale. Every result is checked against the
+// ones a single thread gets for each of the locales.
+
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/application_data.h"
+#include "common/benchmark_utils.h"
+#include "common/locale_manager.h"
+#include "common/picojson.h"
+#include "common/resource_manager.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const int kDefaultIterations = 10000;
+const char kDefaultLocales[] = "en-us,ko-kr";
+const char kDefaultThreads[] = "1,2,4,8";
+
+// Results of the three calls for one url, joined so that they can be
+// compared at once.
+std::string Resolve(common::ResourceManager* resource_manager,
+                    const std::string& url) {
+  std::string result = resource_manager->GetLocalizedPath(url);
+  result += resource_manager->AllowNavigation(url) ? " 1" : " 0";
+  result += resource_manager->AllowedResource(url) ? " 1" : " 0";
+  return result;
+}
+
+struct Worker {
+  common::ResourceManager* resource_manager;
+  const std::vector<std::string>* urls;
+  // Results each url may have, one per locale
+  const std::vector<std::set<std::string>>* expected;
+  int iterations;
+  int mismatches;
+};
+
+gpointer WorkerMain(gpointer data) {
+  Worker* worker = static_cast<Worker*>(data);
+  size_t count = worker->urls->size();
+  for (int i = 0; i < worker->iterations; ++i) {
+    size_t index = i % count;
+    std::string result =
+        Resolve(worker->resource_manager, (*worker->urls)[index]);
+    if ((*worker->expected)[index].count(result) == 0)
+      ++worker->mismatches;
+  }
+  return NULL;
+}
+
+int Run(common::ResourceManager* resource_manager,
+        common::LocaleManager* locale_manager,
+        const std::vector<std::string>& locales,
+        const std::vector<std::string>& urls,
+        const std::vector<std::set<std::string>>& expected,
+        int threads, int iterations) {
+  std::vector<Worker> workers(threads);
+  std::vector<GThread*> handles;
+  double start = benchmark::Now();
+  for (auto& worker : workers) {
+    worker.resource_manager = resource_manager;
+    worker.urls = &urls;
+    worker.expected = &expected;
+    worker.iterations = iterations;
+    worker.mismatches = 0;
+    handles.push_back(g_thread_new("ResourceManager", WorkerMain, &worker));
+  }
+  // Switching the locale makes the workers rebuild the locale state while
+  // others still read the previous one.
+  for (size_t i = 0; i < locales.size() * 100; ++i)
+    locale_manager->SetDefaultLocale(locales[i % locales.size()]);
+  for (auto handle : handles)
+    g_thread_join(handle);
+  double seconds = benchmark::Now() - start;
+
+  int mismatches = 0;
+  for (auto& worker : workers)
+    mismatches += worker.mismatches;
+  double calls = static_cast<double>(threads) * iterations;
+  picojson::object json;
+  json["threads"] = picojson::value(static_cast<double>(threads));
+  json["calls"] = picojson::value(calls);
+  json["seconds"] = picojson::value(seconds);
+  json["us_per_call"] =
+      picojson::value(benchmark::PerItem(seconds, calls, 1e6));
+  json["mismatches"] = picojson::value(static_cast<double>(mismatches));
+  benchmark::PrintResult(json);
+  return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  std::string appid = options.Required("appid", "<app id>");
+  std::vector<std::string> urls = benchmark::Split(
+      options.Required("urls", "<url>[,<url>...]"), ',');
+  std::vector<std::string> locales =
+      options.List("locales", kDefaultLocales);
+  std::vector<int> threads = options.IntList("threads", kDefaultThreads);
+  int iterations = options.Int("iterations", kDefaultIterations);
+  if (appid.empty() || urls.empty())
+    return options.Usage();
+
+  common::ApplicationData app_data(appid);
+  if (!app_data.LoadManifestData()) {
+    fprintf(stderr, "Fail to load the manifest of %s\n", appid.c_str());
+    return EXIT_FAILURE;
+  }
+  common::LocaleManager locale_manager;
+  common::ResourceManager resource_manager(&app_data, &locale_manager);
+  resource_manager.set_base_resource_path(app_data.application_path());
+
+  std::vector<std::set<std::string>> expected(urls.size());
+  for (auto& locale : locales) {
+    locale_manager.SetDefaultLocale(locale);
+    for (size_t i = 0; i < urls.size(); ++i)
+      expected[i].insert(Resolve(&resource_manager, urls[i]));
+  }
+
+  int mismatches = 0;
+  for (int thread_count : threads) {
+    mismatches += Run(&resource_manager, &locale_manager, locales, urls,
+                      expected, thread_count, iterations);
+  }
+  return benchmark::ExitStatus(mismatches);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/resource_prefetcher.h"
+
+#include <app_control.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+#include "common/app_control.h"
+#include "common/app_db.h"
+#include "common/application_data.h"
+#include "common/locale_manager.h"
+#include "common/logger.h"
+#include "common/resource_manager.h"
+#include "common/string_utils.h"
+
+namespace common {
+
+namespace {
+
+const char kPrefetchSection[] = "Prefetch";
+const char kPrefetchResources[] = "resources";
+const char kSchemeTypeFile[] = "file://";
+// Enough for the scripts, styles and images of a start page
+const size_t kMaxRecordedResources = 32;
+// Larger files, e.g. media, are left to be streamed
+const off_t kMaxReadaheadSize = 4 * 1024 * 1024;
+
+void Readahead(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    // Blocks until the pages are read, so that they are read in order
+    readahead(fd, 0, std::min(st.st_size, kMaxReadaheadSize));
+  }
+  close(fd);
+}
+
+// The canonical form of |path|, or an empty string if it doesn't exist.
+std::string RealPath(const std::string& path) {
+  char* resolved = realpath(path.c_str(), NULL);
+  if (resolved == NULL)
+    return std::string();
+  std::string result(resolved);
+  free(resolved);
+  return result;
+}
+
+}  // namespace
+
+ResourcePrefetcher::ResourcePrefetcher(ApplicationData* application_data)
+    : application_data_(application_data),
+      thread_(NULL),
+      stopped_(false) {
+  thread_ = g_thread_new("Prefetch", ThreadMain, this);
+}
+
+ResourcePrefetcher::~ResourcePrefetcher() {
+  // Teardown shouldn't wait for the rest of the files on slow storage.
+  g_atomic_int_set(&stopped_, true);
+  g_thread_join(thread_);
+}
+
+// static
+gpointer ResourcePrefetcher::ThreadMain(gpointer data) {
+  static_cast<ResourcePrefetcher*>(data)->Run();
+  return NULL;
+}
+
+void ResourcePrefetcher::Run() {
+  // The start resource of a normal launch, resolved as WebApplication does.
+  // This thread has its own managers, the ones of WebApplication aren't
+  // created yet.
+  LocaleManager locale_manager;
+  auto widget_info = application_data_->widget_info();
+  if (widget_info != NULL && !widget_info->default_locale().empty())
+    locale_manager.SetDefaultLocale(widget_info->default_locale());
+  ResourceManager resource_manager(application_data_, &locale_manager);
+  resource_manager.set_base_resource_path(
+      application_data_->application_path());
+  AppControl app_control;
+  app_control.set_operation(APP_CONTROL_OPERATION_DEFAULT);
+  std::unique_ptr<ResourceManager::Resource> res =
+      resource_manager.GetStartResource(&app_control);
+  std::string start_path = resource_manager.GetLocalizedPath(res->uri());
+  if (utils::StartsWith(start_path, kSchemeTypeFile)) {
+    start_path.erase(0, strlen(kSchemeTypeFile));
+    if (stopped())
+      return;
+    Readahead(start_path);
+  }
+
+  std::unique_ptr<AppDB> db(AppDB::CreateInstance());
+  std::string recorded;
+  if (!db->TryGet(kPrefetchSection, kPrefetchResources, &recorded))
+    return;
+  // The app db is writable by the application, so only files of the
+  // application are read.
+  std::string root = RealPath(application_data_->application_path());
+  if (root.empty())
+    return;
+  root += "/";
+  std::istringstream stream(recorded);
+  std::string path;
+  while (!stopped() && std::getline(stream, path)) {
+    if (path.empty() || path == start_path)
+      continue;
+    std::string real_path = RealPath(path);
+    if (!utils::StartsWith(real_path, root)) {
+      LOGGER(WARN) << "Ignore the resource out of the application : " << path;
+      continue;
+    }
+    Readahead(real_path);
+  }
+}
+
+ResourceRecorder::ResourceRecorder()
+    : saved_(false) {
+}
+
+void ResourceRecorder::Record(const std::string& url) {
+  // Every load after the first ones ends here, without allocating.
+  if (g_atomic_int_get(&saved_))
+    return;
+  size_t begin = strlen(kSchemeTypeFile);
+  if (url.compare(0, begin, kSchemeTypeFile) != 0)
+    return;
+  size_t end = std::min(url.find_first_of("?#", begin), url.length());
+  if (end == begin)
+    return;
+
+  AutoLock lock(&mutex_);
+  if (saved_)
+    return;
+  for (auto& path : paths_) {
+    if (url.compare(begin, end - begin, path) == 0)
+      return;
+  }
+  paths_.push_back(url.substr(begin, end - begin));
+  if (paths_.size() < kMaxRecordedResources)
+    return;
+  lock.Release();
+  Save();
+}
+
+void ResourceRecorder::Save() {
+  std::string value;
+  {
+    AutoLock lock(&mutex_);
+    if (saved_ || paths_.empty())
+      return;
+    g_atomic_int_set(&saved_, true);
+    for (auto& path : paths_)
+      value.append(path).append("\n");
+  }
+
+  // A connection of its own, this may be called on any thread
+  std::unique_ptr<AppDB> db(AppDB::CreateInstance());
+  AppDB::Transaction transaction(db.get());
+  db->Set(kPrefetchSection, kPrefetchResources, value);
+}
+
+}  // namespace common
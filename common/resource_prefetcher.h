@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_RESOURCE_PREFETCHER_H_
+#define XWALK_COMMON_RESOURCE_PREFETCHER_H_
+
+#include <glib.h>
+
+#include <string>
+#include <vector>
+
+#include "common/mutex.h"
+
+namespace common {
+
+class ApplicationData;
+
+// Reads the start resource of an application into the page cache while the
+// runtime is still starting, so that the first page load doesn't wait for
+// flash. The resources ResourceRecorder recorded on the previous launch are
+// read after it.
+class ResourcePrefetcher {
+ public:
+  // Starts the background thread. |application_data| must outlive the
+  // prefetcher.
+  explicit ResourcePrefetcher(ApplicationData* application_data);
+  // Stops the background thread after the file it is reading.
+  ~ResourcePrefetcher();
+
+  ResourcePrefetcher(const ResourcePrefetcher&) = delete;
+  ResourcePrefetcher& operator=(const ResourcePrefetcher&) = delete;
+
+ private:
+  static gpointer ThreadMain(gpointer data);
+  void Run();
+  bool stopped() const { return g_atomic_int_get(&stopped_); }
+
+  ApplicationData* application_data_;
+  GThread* thread_;
+  // Set by the destructor, checked before each file is read.
+  gint stopped_;
+};
+
+// Records the first local resources an application loads, for
+// ResourcePrefetcher on the next launch. Thread-safe.
+class ResourceRecorder {
+ public:
+  ResourceRecorder();
+
+  // Records |url| if it is a local file, until enough were recorded.
+  void Record(const std::string& url);
+  // Stores the recorded resources, only the first time it is called.
+  void Save();
+
+ private:
+  Mutex mutex_;
+  std::vector<std::string> paths_;
+  // Set under |mutex_|, read atomically so that Record() returns early
+  // once the resources were saved.
+  gint saved_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_RESOURCE_PREFETCHER_H_
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_SHARDED_LRU_CACHE_H_
+#define XWALK_COMMON_SHARDED_LRU_CACHE_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/lru_cache.h"
+#include "common/mutex.h"
+
+namespace common {
+
+// LRUCache that can be used from several threads. Keys are spread over
+// |shards| caches with a lock each, so that threads rarely wait for each
+// other, and each shard gets an equal part of the capacity. Values are
+// copied out, as another thread may evict them at any time.
+template <typename Key, typename Value, typename Hash = std::hash<Key> >
+class ShardedLRUCache {
+ public:
+  ShardedLRUCache(size_t capacity, size_t shards) {
+    if (shards == 0)
+      shards = 1;
+    for (size_t i = 0; i < shards; ++i)
+      shards_.emplace_back(new Shard(ShardCapacity(capacity, shards, i)));
+  }
+
+  bool Get(const Key& key, Value* value) {
+    Shard* shard = ShardFor(key);
+    AutoLock lock(&shard->mutex);
+    const Value* found = shard->cache.Get(key);
+    if (found == NULL)
+      return false;
+    *value = *found;
+    return true;
+  }
+
+  void Put(const Key& key, const Value& value, size_t cost = 1) {
+    Shard* shard = ShardFor(key);
+    AutoLock lock(&shard->mutex);
+    shard->cache.Put(key, value, cost);
+  }
+
+  void Remove(const Key& key) {
+    Shard* shard = ShardFor(key);
+    AutoLock lock(&shard->mutex);
+    shard->cache.Remove(key);
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      AutoLock lock(&shard->mutex);
+      shard->cache.Clear();
+    }
+  }
+
+  void set_capacity(size_t capacity) {
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      AutoLock lock(&shards_[i]->mutex);
+      shards_[i]->cache.set_capacity(
+          ShardCapacity(capacity, shards_.size(), i));
+    }
+  }
+
+  // Sums of all the shards.
+  CacheStatistics statistics() const {
+    CacheStatistics total = {0, 0, 0, 0, 0};
+    for (auto& shard : shards_) {
+      AutoLock lock(&shard->mutex);
+      CacheStatistics stats = shard->cache.statistics();
+      total.hits += stats.hits;
+      total.misses += stats.misses;
+      total.size += stats.size;
+      total.cost += stats.cost;
+      total.capacity += stats.capacity;
+    }
+    return total;
+  }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : cache(capacity) {}
+
+    Mutex mutex;
+    LRUCache<Key, Value, Hash> cache;
+  };
+
+  static size_t ShardCapacity(size_t capacity, size_t shards, size_t index) {
+    return capacity / shards + (index < capacity % shards ? 1 : 0);
+  }
+
+  Shard* ShardFor(const Key& key) const {
+    return shards_[Hash()(key) % shards_.size()].get();
+  }
+
+  std::vector<std::unique_ptr<Shard> > shards_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_SHARDED_LRU_CACHE_H_
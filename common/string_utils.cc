@@ -19,6 +19,7 @@
 #include <curl/curl.h>
 #include <uuid/uuid.h>
 #include <glib.h>
+#include <ctype.h>
 #include <math.h>
 #include <time.h>
 
@@ -35,6 +36,12 @@ namespace utils {
 namespace {
 std::unique_ptr<CURL, decltype(curl_easy_cleanup)*>
     g_curl {nullptr, curl_easy_cleanup};
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  return (c | 0x20) - 'a' + 10;
+}
 }  // namespace
 
 std::string GenerateUUID() {
@@ -90,14 +97,24 @@ bool SplitString(const std::string &str,
 }
 
 std::string UrlDecode(const std::string& url) {
-  if (g_curl.get() == nullptr) {
-    g_curl.reset(curl_easy_init());
+  // Decoded in place of curl_easy_unescape(), which needs the shared curl
+  // handle and so can't be called from several threads at once.
+  std::string decoded;
+  decoded.reserve(url.length());
+  for (size_t i = 0; i < url.length(); ++i) {
+    char c = url[i];
+    if (c == '%' && i + 2 < url.length() &&
+        isxdigit(static_cast<unsigned char>(url[i + 1])) &&
+        isxdigit(static_cast<unsigned char>(url[i + 2]))) {
+      c = static_cast<char>(HexValue(url[i + 1]) << 4 | HexValue(url[i + 2]));
+      i += 2;
+    }
+    // curl's result was read as a C string, so stop at a decoded NUL
+    if (c == '\0')
+      break;
+    decoded.push_back(c);
   }
-  std::unique_ptr<char, decltype(curl_free)*> decoded_str {
-      curl_easy_unescape(g_curl.get(), url.c_str(), url.length(), NULL),
-      curl_free };
-
-  return decoded_str.get() != nullptr ? std::string(decoded_str.get()) : url;
+  return decoded;
 }
 
 std::string UrlEncode(const std::string& url) {
@@ -117,5 +134,18 @@ std::string Base64Encode(const unsigned char* data, size_t len) {
   return std::string(encoded);
 }
 
+void AppendBase64(const unsigned char* data, size_t len,
+                  std::string* output) {
+  size_t offset = output->size();
+  // the size g_base64_encode_step() asks for, the close step fits in it
+  output->resize(offset + (len / 3 + 1) * 4 + 4);
+  gchar* out = &(*output)[offset];
+  gint state = 0;
+  gint save = 0;
+  gsize written = g_base64_encode_step(data, len, FALSE, out, &state, &save);
+  written += g_base64_encode_close(FALSE, out + written, &state, &save);
+  output->resize(offset + written);
+}
+
 }  // namespace utils
 }  // namespace common
@@ -34,6 +34,8 @@ bool SplitString(const std::string &str,
 std::string UrlEncode(const std::string& url);
 std::string UrlDecode(const std::string& url);
 std::string Base64Encode(const unsigned char* data, size_t len);
+// Encodes |data| straight into the end of |output|.
+void AppendBase64(const unsigned char* data, size_t len, std::string* output);
 
 }  // namespace utils
 }  // namespace common
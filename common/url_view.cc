@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "common/url_view.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace common {
+
+namespace {
+
+const char kSchemeTypeFile[] = "file";
+
+// length of scheme identifier ://
+const size_t kSchemeIdLen = 3;
+
+const struct {
+  const char* scheme;
+  int port;
+} kDefaultPorts[] = {
+  {"http", 80},
+  {"https", 443},
+  {"ssh", 22},
+  {"ftp", 21},
+};
+const int kPortDefault = 0;
+
+// Returns |length| if |c| isn't found.
+size_t Find(const char* data, size_t length, char c, size_t start) {
+  if (start >= length)
+    return length;
+  const void* found = memchr(data + start, c, length - start);
+  return found != NULL ? static_cast<const char*>(found) - data : length;
+}
+
+size_t FindSchemeSeparator(const char* data, size_t length) {
+  size_t pos = Find(data, length, ':', 0);
+  while (pos + kSchemeIdLen <= length) {
+    if (data[pos + 1] == '/' && data[pos + 2] == '/')
+      return pos;
+    pos = Find(data, length, ':', pos + 1);
+  }
+  return length;
+}
+
+// Parses |port| as std::stoi() does: leading spaces and a sign are skipped
+// and whatever follows the digits is ignored.
+bool ParsePort(const char* data, size_t length, int* port) {
+  size_t i = 0;
+  while (i < length && isspace(static_cast<unsigned char>(data[i])))
+    ++i;
+  bool negative = false;
+  if (i < length && (data[i] == '+' || data[i] == '-')) {
+    negative = data[i] == '-';
+    ++i;
+  }
+  size_t digits_start = i;
+  int64_t value = 0;
+  for (; i < length && data[i] >= '0' && data[i] <= '9'; ++i) {
+    value = value * 10 + (data[i] - '0');
+    if (value > static_cast<int64_t>(INT_MAX) + 1)
+      return false;
+  }
+  if (i == digits_start)
+    return false;
+  if (negative)
+    value = -value;
+  if (value > INT_MAX)
+    return false;
+  *port = static_cast<int>(value);
+  return true;
+}
+
+}  // namespace
+
+URLView::URLView(const char* url, size_t length)
+    : url_(url, length),
+      port_(0) {
+  Parse();
+}
+
+URLView::URLView(const std::string& url)
+    : url_(url.data(), url.length()),
+      port_(0) {
+  Parse();
+}
+
+bool URLView::SchemeIs(const char* scheme) const {
+  size_t i = 0;
+  for (; i < scheme_.length; ++i) {
+    if (scheme[i] == '\0' ||
+        tolower(static_cast<unsigned char>(scheme_.data[i])) != scheme[i])
+      return false;
+  }
+  return scheme[i] == '\0';
+}
+
+void URLView::AppendScheme(std::string* out) const {
+  for (size_t i = 0; i < scheme_.length; ++i)
+    out->push_back(tolower(static_cast<unsigned char>(scheme_.data[i])));
+}
+
+void URLView::Parse() {
+  const char* data = url_.data;
+  size_t length = url_.length;
+  size_t end_of_scheme = FindSchemeSeparator(data, length);
+  if (end_of_scheme == length) {
+    // No scheme, the domain runs to the path
+    size_t end_of_domain = Find(data, length, '/', 0);
+    domain_ = URLComponent(data, end_of_domain);
+    path_ = domain_.empty() ?
+        url_ : URLComponent(data + end_of_domain, length - end_of_domain);
+    return;
+  }
+
+  scheme_ = URLComponent(data, end_of_scheme);
+  // As in URL, the separator is part of the rest when the scheme is empty
+  size_t start = scheme_.empty() ? 0 : end_of_scheme + kSchemeIdLen;
+  if (!SchemeIs(kSchemeTypeFile))
+    ParseDomainPort(start);
+
+  if (domain_.empty()) {
+    path_ = URLComponent(data + start, length - start);
+  } else {
+    size_t start_of_path = Find(data, length, '/', start);
+    path_ = URLComponent(data + start_of_path, length - start_of_path);
+  }
+}
+
+void URLView::ParseDomainPort(size_t start) {
+  const char* domain = url_.data + start;
+  size_t length = Find(url_.data, url_.length, '/', start) - start;
+
+  int default_port = kPortDefault;
+  for (auto& entry : kDefaultPorts) {
+    if (SchemeIs(entry.scheme)) {
+      default_port = entry.port;
+      break;
+    }
+  }
+
+  // Decide start position to find port considering IPv6 case
+  size_t start_pos = Find(domain, length, '@', 0);
+  start_pos = start_pos < length ? start_pos + 1 : 0;
+  if (start_pos < length && domain[start_pos] == '[') {
+    start_pos = Find(domain, length, ']', start_pos + 1);
+    if (start_pos == length)
+      start_pos = 0;
+  }
+
+  size_t port_separator = Find(domain, length, ':', start_pos);
+  if (port_separator == length) {
+    domain_ = URLComponent(domain, length);
+    port_ = default_port;
+    return;
+  }
+  domain_ = URLComponent(domain, port_separator);
+  if (!ParsePort(domain + port_separator + 1, length - port_separator - 1,
+                 &port_)) {
+    port_ = default_port;
+  }
+}
+
+}  // namespace common
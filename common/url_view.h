@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_COMMON_URL_VIEW_H_
+#define XWALK_COMMON_URL_VIEW_H_
+
+#include <stddef.h>
+
+#include <string>
+
+namespace common {
+
+// A part of the string a URLView was made from.
+struct URLComponent {
+  URLComponent() : data(NULL), length(0) {}
+  URLComponent(const char* data, size_t length)
+      : data(data), length(length) {}
+
+  bool empty() const { return length == 0; }
+  std::string ToString() const { return std::string(data, length); }
+
+  const char* data;
+  size_t length;
+};
+
+// Parses a url the way URL does, without allocating or copying: the
+// components point into the parsed string, which has to outlive the
+// URLView. Unlike URL::scheme(), scheme() is not lowercased, use SchemeIs()
+// or AppendScheme() to get the same results.
+class URLView {
+ public:
+  URLView(const char* url, size_t length);
+  explicit URLView(const std::string& url);
+
+  const URLComponent& url() const { return url_; }
+  const URLComponent& scheme() const { return scheme_; }
+  const URLComponent& domain() const { return domain_; }
+  int port() const { return port_; }
+  const URLComponent& path() const { return path_; }
+
+  // |scheme| has to be lowercase.
+  bool SchemeIs(const char* scheme) const;
+  // Appends the lowercase scheme to |out|.
+  void AppendScheme(std::string* out) const;
+
+ private:
+  void Parse();
+  void ParseDomainPort(size_t start);
+
+  URLComponent url_;
+  URLComponent scheme_;
+  URLComponent domain_;
+  int port_;
+  URLComponent path_;
+};
+
+}  // namespace common
+
+#endif  // XWALK_COMMON_URL_VIEW_H_
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Compares URLView with URL on generated urls: every component has to be
+// the same, then both are timed building the origin ResourceManager caches
+// access checks by.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "common/benchmark_utils.h"
+#include "common/picojson.h"
+#include "common/url.h"
+#include "common/url_view.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const int kDefaultRandom = 100000;
+const int kDefaultIterations = 100;
+
+// Every combination of the parts URL treats specially, then |random| short
+// strings of the characters it splits on.
+std::vector<std::string> MakeUrls(int random) {
+  const char* schemes[] = {"http://", "HTTPS://", "file://", "File://",
+                           "ftp://", "ssh://", "app://", "://", "http:/", ""};
+  const char* users[] = {"", "user@", "user:pass@", "@", "a@b@"};
+  const char* hosts[] = {"www.example.com", "[::1]", "[fe80::1", "[]", "",
+                         "a..b", "127.0.0.1"};
+  const char* ports[] = {"", ":", ":8080", ": 81", ":+9", ":-1", ":80abc",
+                         ":x", ":99999999999", ":2147483647"};
+  const char* paths[] = {"", "/", "/a/b?c=d#e", "/x:y//z", "//"};
+  std::vector<std::string> urls;
+  for (auto scheme : schemes) {
+    for (auto user : users) {
+      for (auto host : hosts) {
+        for (auto port : ports) {
+          for (auto path : paths) {
+            urls.push_back(std::string(scheme) + user + host + port + path);
+          }
+        }
+      }
+    }
+  }
+
+  const char alphabet[] = ":/@[]. a1F";
+  unsigned int seed = 1;
+  for (int i = 0; i < random; ++i) {
+    std::string url;
+    int length = rand_r(&seed) % 16;
+    for (int j = 0; j < length; ++j)
+      url.push_back(alphabet[rand_r(&seed) % (sizeof(alphabet) - 1)]);
+    urls.push_back(url);
+  }
+  return urls;
+}
+
+bool Same(const std::string& url) {
+  common::URL expected(url);
+  common::URLView view(url);
+  std::string scheme;
+  view.AppendScheme(&scheme);
+  return expected.url() == view.url().ToString() &&
+         expected.scheme() == scheme &&
+         expected.domain() == view.domain().ToString() &&
+         expected.port() == view.port() &&
+         expected.path() == view.path().ToString();
+}
+
+void PrintResult(const std::string& parser, size_t urls, double seconds) {
+  picojson::object json;
+  json["parser"] = picojson::value(parser);
+  json["urls"] = picojson::value(static_cast<double>(urls));
+  json["seconds"] = picojson::value(seconds);
+  json["ns_per_url"] = picojson::value(benchmark::PerItem(seconds, urls, 1e9));
+  benchmark::PrintResult(json);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  int random = options.Int("random", kDefaultRandom);
+  int iterations = options.Int("iterations", kDefaultIterations);
+  std::vector<std::string> urls = MakeUrls(random);
+
+  int mismatches = 0;
+  for (auto& url : urls) {
+    if (!Same(url)) {
+      fprintf(stderr, "Mismatch for \"%s\"\n", url.c_str());
+      ++mismatches;
+    }
+  }
+
+  // Timed on the web urls access checks see
+  std::vector<std::string> web_urls;
+  for (auto& url : urls) {
+    if (url.compare(0, 7, "http://") == 0)
+      web_urls.push_back(url);
+  }
+  size_t calls = web_urls.size() * iterations;
+
+  size_t total = 0;
+  double start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    for (auto& url : web_urls) {
+      common::URL url_info(url);
+      total += url_info.scheme().length() + url_info.domain().length() +
+               url_info.port();
+    }
+  }
+  PrintResult("url", calls, benchmark::Now() - start);
+
+  size_t view_total = 0;
+  start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    for (auto& url : web_urls) {
+      common::URLView url_info(url);
+      view_total += url_info.scheme().length + url_info.domain().length +
+                    url_info.port();
+    }
+  }
+  PrintResult("view", calls, benchmark::Now() - start);
+
+  if (total != view_total)
+    ++mismatches;
+  return benchmark::ExitStatus(mismatches);
+}
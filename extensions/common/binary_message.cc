@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "extensions/common/binary_message.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "common/picojson.h"
+
+namespace extensions {
+
+namespace {
+
+const uint8_t kMajorUnsigned = 0;
+const uint8_t kMajorNegative = 1;
+const uint8_t kMajorText = 3;
+const uint8_t kMajorArray = 4;
+const uint8_t kMajorMap = 5;
+const uint8_t kMajorSimple = 7;
+
+const uint8_t kFalse = 0xf4;
+const uint8_t kTrue = 0xf5;
+const uint8_t kNull = 0xf6;
+const uint8_t kDouble = 0xfb;
+
+// Nesting deeper than this is rejected instead of exhausting the stack.
+const int kMaxDepth = 64;
+
+bool ReadValue(BinaryMessageReader* reader, int depth,
+               picojson::value* value) {
+  if (depth > kMaxDepth)
+    return false;
+
+  switch (reader->PeekType()) {
+    case kBinaryMessageInteger: {
+      int64_t number;
+      if (!reader->ReadInteger(&number))
+        return false;
+      *value = picojson::value(static_cast<double>(number));
+      return true;
+    }
+    case kBinaryMessageDouble: {
+      double number;
+      if (!reader->ReadDouble(&number))
+        return false;
+      *value = picojson::value(number);
+      return true;
+    }
+    case kBinaryMessageString: {
+      const char* data;
+      size_t length;
+      if (!reader->ReadString(&data, &length))
+        return false;
+      *value = picojson::value(std::string(data, length));
+      return true;
+    }
+    case kBinaryMessageBoolean: {
+      bool boolean;
+      if (!reader->ReadBoolean(&boolean))
+        return false;
+      *value = picojson::value(boolean);
+      return true;
+    }
+    case kBinaryMessageNull:
+      *value = picojson::value();
+      return reader->ReadNull();
+    case kBinaryMessageArray: {
+      size_t count;
+      if (!reader->ReadArrayHeader(&count))
+        return false;
+      picojson::array array;
+      for (size_t i = 0; i < count; ++i) {
+        picojson::value item;
+        if (!ReadValue(reader, depth + 1, &item))
+          return false;
+        array.push_back(item);
+      }
+      *value = picojson::value(array);
+      return true;
+    }
+    case kBinaryMessageMap: {
+      size_t count;
+      if (!reader->ReadMapHeader(&count))
+        return false;
+      picojson::object object;
+      for (size_t i = 0; i < count; ++i) {
+        const char* key;
+        size_t key_length;
+        if (!reader->ReadString(&key, &key_length))
+          return false;
+        if (!ReadValue(reader, depth + 1,
+                       &object[std::string(key, key_length)]))
+          return false;
+      }
+      *value = picojson::value(object);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void BinaryMessageWriter::WriteHeader(uint8_t major_type, uint64_t value) {
+  uint8_t type = major_type << 5;
+  if (value < 24) {
+    data_.push_back(type | static_cast<uint8_t>(value));
+    return;
+  }
+
+  int bytes;
+  if (value <= 0xff) {
+    data_.push_back(type | 24);
+    bytes = 1;
+  } else if (value <= 0xffff) {
+    data_.push_back(type | 25);
+    bytes = 2;
+  } else if (value <= 0xffffffffULL) {
+    data_.push_back(type | 26);
+    bytes = 4;
+  } else {
+    data_.push_back(type | 27);
+    bytes = 8;
+  }
+  for (int i = bytes - 1; i >= 0; --i) {
+    data_.push_back(static_cast<uint8_t>(value >> (i * 8)));
+  }
+}
+
+void BinaryMessageWriter::WriteNull() {
+  data_.push_back(kNull);
+}
+
+void BinaryMessageWriter::WriteBoolean(bool value) {
+  data_.push_back(value ? kTrue : kFalse);
+}
+
+void BinaryMessageWriter::WriteInteger(int64_t value) {
+  if (value >= 0)
+    WriteHeader(kMajorUnsigned, static_cast<uint64_t>(value));
+  else
+    WriteHeader(kMajorNegative, static_cast<uint64_t>(-(value + 1)));
+}
+
+void BinaryMessageWriter::WriteDouble(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  data_.push_back(kDouble);
+  for (int i = 7; i >= 0; --i) {
+    data_.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+  }
+}
+
+void BinaryMessageWriter::WriteString(const char* data, size_t length) {
+  WriteHeader(kMajorText, length);
+  data_.insert(data_.end(), data, data + length);
+}
+
+void BinaryMessageWriter::WriteArrayHeader(size_t count) {
+  WriteHeader(kMajorArray, count);
+}
+
+void BinaryMessageWriter::WriteMapHeader(size_t count) {
+  WriteHeader(kMajorMap, count);
+}
+
+BinaryMessageReader::BinaryMessageReader(const uint8_t* data, size_t size)
+    : data_(data),
+      size_(size),
+      pos_(0) {
+}
+
+BinaryMessageType BinaryMessageReader::PeekType() const {
+  if (pos_ >= size_)
+    return kBinaryMessageInvalid;
+
+  uint8_t initial = data_[pos_];
+  switch (initial >> 5) {
+    case kMajorUnsigned:
+    case kMajorNegative:
+      return kBinaryMessageInteger;
+    case kMajorText:
+      return kBinaryMessageString;
+    case kMajorArray:
+      return kBinaryMessageArray;
+    case kMajorMap:
+      return kBinaryMessageMap;
+    case kMajorSimple:
+      if (initial == kFalse || initial == kTrue)
+        return kBinaryMessageBoolean;
+      if (initial == kNull)
+        return kBinaryMessageNull;
+      if (initial == kDouble)
+        return kBinaryMessageDouble;
+      return kBinaryMessageInvalid;
+    default:
+      return kBinaryMessageInvalid;
+  }
+}
+
+bool BinaryMessageReader::ReadHeader(uint8_t major_type, uint64_t* value) {
+  if (pos_ >= size_ || (data_[pos_] >> 5) != major_type)
+    return false;
+
+  uint8_t additional = data_[pos_] & 0x1f;
+  if (additional < 24) {
+    *value = additional;
+    pos_++;
+    return true;
+  }
+  if (additional > 27)
+    return false;
+
+  size_t bytes = 1 << (additional - 24);
+  if (size_ - pos_ - 1 < bytes)
+    return false;
+  uint64_t result = 0;
+  for (size_t i = 1; i <= bytes; ++i) {
+    result = (result << 8) | data_[pos_ + i];
+  }
+  pos_ += bytes + 1;
+  *value = result;
+  return true;
+}
+
+bool BinaryMessageReader::ReadNull() {
+  if (pos_ >= size_ || data_[pos_] != kNull)
+    return false;
+  pos_++;
+  return true;
+}
+
+bool BinaryMessageReader::ReadBoolean(bool* value) {
+  if (pos_ >= size_ || (data_[pos_] != kFalse && data_[pos_] != kTrue))
+    return false;
+  *value = data_[pos_] == kTrue;
+  pos_++;
+  return true;
+}
+
+bool BinaryMessageReader::ReadInteger(int64_t* value) {
+  if (pos_ >= size_)
+    return false;
+  uint8_t major_type = data_[pos_] >> 5;
+  uint64_t raw;
+  if (!ReadHeader(major_type, &raw) ||
+      raw > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+    return false;
+  if (major_type == kMajorUnsigned) {
+    *value = static_cast<int64_t>(raw);
+    return true;
+  }
+  if (major_type == kMajorNegative) {
+    *value = -1 - static_cast<int64_t>(raw);
+    return true;
+  }
+  return false;
+}
+
+bool BinaryMessageReader::ReadDouble(double* value) {
+  if (size_ - pos_ < 9 || data_[pos_] != kDouble)
+    return false;
+  uint64_t bits = 0;
+  for (size_t i = 1; i <= 8; ++i) {
+    bits = (bits << 8) | data_[pos_ + i];
+  }
+  memcpy(value, &bits, sizeof(bits));
+  pos_ += 9;
+  return true;
+}
+
+bool BinaryMessageReader::ReadString(const char** data, size_t* length) {
+  uint64_t raw;
+  if (!ReadHeader(kMajorText, &raw) || raw > size_ - pos_)
+    return false;
+  *data = reinterpret_cast<const char*>(data_ + pos_);
+  *length = static_cast<size_t>(raw);
+  pos_ += *length;
+  return true;
+}
+
+bool BinaryMessageReader::ReadArrayHeader(size_t* count) {
+  uint64_t raw;
+  // Every item takes at least one byte.
+  if (!ReadHeader(kMajorArray, &raw) || raw > size_ - pos_)
+    return false;
+  *count = static_cast<size_t>(raw);
+  return true;
+}
+
+bool BinaryMessageReader::ReadMapHeader(size_t* count) {
+  uint64_t raw;
+  // Every key and value takes at least one byte.
+  if (!ReadHeader(kMajorMap, &raw) || raw > (size_ - pos_) / 2)
+    return false;
+  *count = static_cast<size_t>(raw);
+  return true;
+}
+
+bool BinaryMessageToJSON(const uint8_t* data, size_t size, std::string* json) {
+  BinaryMessageReader reader(data, size);
+  picojson::value value;
+  if (!ReadValue(&reader, 0, &value) || !reader.AtEnd())
+    return false;
+  *json = value.serialize();
+  return true;
+}
+
+}  // namespace extensions
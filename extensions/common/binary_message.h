@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_EXTENSIONS_COMMON_BINARY_MESSAGE_H_
+#define XWALK_EXTENSIONS_COMMON_BINARY_MESSAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace extensions {
+
+// Binary messages exchanged between the extension JS code and native
+// extensions use a subset of CBOR (RFC 7049): unsigned and negative
+// integers, text strings, arrays, maps with text string keys, false, true,
+// null and double precision floats. Only definite lengths are used.
+
+enum BinaryMessageType {
+  kBinaryMessageInvalid,
+  kBinaryMessageInteger,
+  kBinaryMessageString,
+  kBinaryMessageArray,
+  kBinaryMessageMap,
+  kBinaryMessageBoolean,
+  kBinaryMessageNull,
+  kBinaryMessageDouble,
+};
+
+class BinaryMessageWriter {
+ public:
+  BinaryMessageWriter() {}
+
+  void WriteNull();
+  void WriteBoolean(bool value);
+  void WriteInteger(int64_t value);
+  void WriteDouble(double value);
+  void WriteString(const char* data, size_t length);
+  // Starts an array of |count| items, or a map of |count| key/value pairs.
+  // The items follow as separate Write calls.
+  void WriteArrayHeader(size_t count);
+  void WriteMapHeader(size_t count);
+
+  const std::vector<uint8_t>& data() const { return data_; }
+
+ private:
+  void WriteHeader(uint8_t major_type, uint64_t value);
+
+  std::vector<uint8_t> data_;
+};
+
+// Reads a binary message in place. Strings are returned as pointers into the
+// message, so the buffer must outlive the values read from it.
+class BinaryMessageReader {
+ public:
+  BinaryMessageReader(const uint8_t* data, size_t size);
+
+  // Type of the next item, without consuming it.
+  BinaryMessageType PeekType() const;
+  bool AtEnd() const { return pos_ == size_; }
+
+  bool ReadNull();
+  bool ReadBoolean(bool* value);
+  bool ReadInteger(int64_t* value);
+  bool ReadDouble(double* value);
+  bool ReadString(const char** data, size_t* length);
+  bool ReadArrayHeader(size_t* count);
+  bool ReadMapHeader(size_t* count);
+
+ private:
+  bool ReadHeader(uint8_t major_type, uint64_t* value);
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_;
+};
+
+// Converts a binary message to its JSON text, for native extensions that
+// only handle JSON messages. Returns false if the message is malformed.
+bool BinaryMessageToJSON(const uint8_t* data, size_t size, std::string* json);
+
+}  // namespace extensions
+
+#endif  // XWALK_EXTENSIONS_COMMON_BINARY_MESSAGE_H_
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+// Compares the ways a message object reaches a native extension: as JSON
+// text ("json"), as a binary message the extension process turns back into
+// JSON for extensions without a binary handler ("binary"), or as a binary
+// message the extension reads itself ("binary_native"). picojson stands in
+// for JSON.stringify and JSON.parse on both ends, and each binary message
+// has to convert back to the same JSON.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/benchmark_utils.h"
+#include "common/picojson.h"
+#include "extensions/common/binary_message.h"
+
+namespace {
+
+namespace benchmark = common::benchmark;
+
+const int kDefaultIterations = 100000;
+
+struct Message {
+  std::string name;
+  picojson::value value;
+};
+
+// Walks |value| the way the renderer walks a V8 value.
+void Write(const picojson::value& value,
+           extensions::BinaryMessageWriter* writer) {
+  if (value.is<picojson::null>()) {
+    writer->WriteNull();
+  } else if (value.is<bool>()) {
+    writer->WriteBoolean(value.get<bool>());
+  } else if (value.is<double>()) {
+    double number = value.get<double>();
+    int64_t integer = static_cast<int64_t>(number);
+    if (integer == number)
+      writer->WriteInteger(integer);
+    else
+      writer->WriteDouble(number);
+  } else if (value.is<std::string>()) {
+    const std::string& str = value.get<std::string>();
+    writer->WriteString(str.data(), str.size());
+  } else if (value.is<picojson::array>()) {
+    const picojson::array& array = value.get<picojson::array>();
+    writer->WriteArrayHeader(array.size());
+    for (auto& item : array)
+      Write(item, writer);
+  } else {
+    const picojson::object& object = value.get<picojson::object>();
+    writer->WriteMapHeader(object.size());
+    for (auto& pair : object) {
+      writer->WriteString(pair.first.data(), pair.first.size());
+      Write(pair.second, writer);
+    }
+  }
+}
+
+// Reads every item of a binary message, the way an extension with a binary
+// handler does.
+bool Read(extensions::BinaryMessageReader* reader) {
+  size_t count;
+  switch (reader->PeekType()) {
+    case extensions::kBinaryMessageInteger: {
+      int64_t number;
+      return reader->ReadInteger(&number);
+    }
+    case extensions::kBinaryMessageDouble: {
+      double number;
+      return reader->ReadDouble(&number);
+    }
+    case extensions::kBinaryMessageString: {
+      const char* data;
+      size_t length;
+      return reader->ReadString(&data, &length);
+    }
+    case extensions::kBinaryMessageBoolean: {
+      bool boolean;
+      return reader->ReadBoolean(&boolean);
+    }
+    case extensions::kBinaryMessageNull:
+      return reader->ReadNull();
+    case extensions::kBinaryMessageArray:
+      if (!reader->ReadArrayHeader(&count))
+        return false;
+      break;
+    case extensions::kBinaryMessageMap:
+      if (!reader->ReadMapHeader(&count))
+        return false;
+      count *= 2;
+      break;
+    default:
+      return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (!Read(reader))
+      return false;
+  }
+  return true;
+}
+
+// A call with a couple of arguments, a result record and a bulk transfer,
+// which is where the extensions send most of their bytes.
+std::vector<Message> MakeMessages() {
+  std::vector<Message> messages;
+
+  picojson::object small;
+  small["cmd"] = picojson::value("getCapability");
+  small["callbackId"] = picojson::value(42.0);
+  small["key"] = picojson::value("http://tizen.org/feature/screen");
+  messages.push_back(Message{"small", picojson::value(small)});
+
+  picojson::object record;
+  for (int i = 0; i < 20; ++i) {
+    std::ostringstream key;
+    key << "field" << i;
+    switch (i % 4) {
+      case 0:
+        record[key.str()] = picojson::value(key.str() + " value");
+        break;
+      case 1:
+        record[key.str()] = picojson::value(i * 1000.0);
+        break;
+      case 2:
+        record[key.str()] = picojson::value(i * 0.25);
+        break;
+      default:
+        record[key.str()] = picojson::value(i % 2 == 0);
+        break;
+    }
+  }
+  picojson::array records;
+  for (int i = 0; i < 10; ++i)
+    records.push_back(picojson::value(record));
+  picojson::object medium;
+  medium["cmd"] = picojson::value("find");
+  medium["result"] = picojson::value(records);
+  messages.push_back(Message{"medium", picojson::value(medium)});
+
+  picojson::array samples;
+  for (int i = 0; i < 4096; ++i)
+    samples.push_back(picojson::value(static_cast<double>(i * 37 % 256)));
+  picojson::object large;
+  large["cmd"] = picojson::value("write");
+  large["data"] = picojson::value(samples);
+  messages.push_back(Message{"large", picojson::value(large)});
+
+  return messages;
+}
+
+void PrintResult(const std::string& path, const Message& message,
+                 size_t bytes, int iterations, double seconds) {
+  picojson::object json;
+  json["path"] = picojson::value(path);
+  json["message"] = picojson::value(message.name);
+  json["bytes"] = picojson::value(static_cast<double>(bytes));
+  json["messages"] = picojson::value(static_cast<double>(iterations));
+  json["seconds"] = picojson::value(seconds);
+  json["ns_per_message"] =
+      picojson::value(benchmark::PerItem(seconds, iterations, 1e9));
+  benchmark::PrintResult(json);
+}
+
+// Returns false if the binary message doesn't convert back to |message|.
+bool Run(const Message& message, int iterations) {
+  std::string text;
+  picojson::value parsed;
+  double start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    text = message.value.serialize();
+    picojson::parse(parsed, text.begin(), text.end(), NULL);
+  }
+  PrintResult("json", message, text.size(), iterations,
+              benchmark::Now() - start);
+
+  size_t bytes = 0;
+  std::string json;
+  start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    extensions::BinaryMessageWriter writer;
+    Write(message.value, &writer);
+    const std::vector<uint8_t>& data = writer.data();
+    bytes = data.size();
+    extensions::BinaryMessageToJSON(data.data(), data.size(), &json);
+    picojson::parse(parsed, json.begin(), json.end(), NULL);
+  }
+  PrintResult("binary", message, bytes, iterations,
+              benchmark::Now() - start);
+  bool same = parsed == message.value;
+
+  start = benchmark::Now();
+  for (int i = 0; i < iterations; ++i) {
+    extensions::BinaryMessageWriter writer;
+    Write(message.value, &writer);
+    const std::vector<uint8_t>& data = writer.data();
+    extensions::BinaryMessageReader reader(data.data(), data.size());
+    same = Read(&reader) && reader.AtEnd() && same;
+  }
+  PrintResult("binary_native", message, bytes, iterations,
+              benchmark::Now() - start);
+
+  return same;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  benchmark::Options options(argc, argv);
+  int iterations = options.Int("iterations", kDefaultIterations);
+
+  int mismatches = 0;
+  for (auto& message : MakeMessages()) {
+    if (!Run(message, iterations)) {
+      fprintf(stderr, "%s: binary message doesn't match JSON\n",
+              message.name.c_str());
+      ++mismatches;
+    }
+  }
+  return benchmark::ExitStatus(mismatches);
+}
@@ -25,7 +25,12 @@ const char kMethodCreateInstance[] = "CreateInstance";
 const char kMethodDestroyInstance[] = "DestroyInstance";
 const char kMethodSendSyncMessage[] = "SendSyncMessage";
 const char kMethodPostMessage[] = "PostMessage";
+const char kMethodSendAsyncMessage[] = "SendAsyncMessage";
+const char kMethodPostBinaryMessage[] = "PostBinaryMessage";
+const char kMethodSendSyncBinaryMessage[] = "SendSyncBinaryMessage";
 const char kSignalOnMessageToJS[] = "OnMessageToJS";
+const char kSignalOnAsyncReplyToJS[] = "OnAsyncReplyToJS";
+const char kSignalOnPropertyChangedToJS[] = "OnPropertyChangedToJS";
 const char kMethodGetJavascriptCode[] = "GetJavascriptCode";
 
 }  // namespace extensions
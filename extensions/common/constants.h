@@ -26,7 +26,12 @@ extern const char kMethodCreateInstance[];
 extern const char kMethodDestroyInstance[];
 extern const char kMethodSendSyncMessage[];
 extern const char kMethodPostMessage[];
+extern const char kMethodSendAsyncMessage[];
+extern const char kMethodPostBinaryMessage[];
+extern const char kMethodSendSyncBinaryMessage[];
 extern const char kSignalOnMessageToJS[];
+extern const char kSignalOnAsyncReplyToJS[];
+extern const char kSignalOnPropertyChangedToJS[];
 extern const char kMethodGetJavascriptCode[];
 
 }  // namespace extensions
@@ -26,7 +26,10 @@ XWalkExtension::XWalkExtension(const std::string& path,
     destroyed_instance_callback_(NULL),
     shutdown_callback_(NULL),
     handle_msg_callback_(NULL),
-    handle_sync_msg_callback_(NULL) {
+    handle_sync_msg_callback_(NULL),
+    handle_async_msg_callback_(NULL),
+    handle_binary_msg_callback_(NULL),
+    handle_binary_sync_msg_callback_(NULL) {
 }
 
 XWalkExtension::XWalkExtension(const std::string& path,
@@ -45,7 +48,10 @@ XWalkExtension::XWalkExtension(const std::string& path,
     destroyed_instance_callback_(NULL),
     shutdown_callback_(NULL),
     handle_msg_callback_(NULL),
-    handle_sync_msg_callback_(NULL) {
+    handle_sync_msg_callback_(NULL),
+    handle_async_msg_callback_(NULL),
+    handle_binary_msg_callback_(NULL),
+    handle_binary_sync_msg_callback_(NULL) {
 }
 
 XWalkExtension::~XWalkExtension() {
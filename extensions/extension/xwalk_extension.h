@@ -11,6 +11,8 @@
 
 #include "extensions/extension/xwalk_extension_instance.h"
 #include "extensions/public/XW_Extension.h"
+#include "extensions/public/XW_Extension_AsyncMessage.h"
+#include "extensions/public/XW_Extension_BinaryMessage.h"
 #include "extensions/public/XW_Extension_SyncMessage.h"
 
 namespace extensions {
@@ -91,6 +93,9 @@ class XWalkExtension {
   XW_ShutdownCallback shutdown_callback_;
   XW_HandleMessageCallback handle_msg_callback_;
   XW_HandleSyncMessageCallback handle_sync_msg_callback_;
+  XW_HandleAsyncMessageCallback handle_async_msg_callback_;
+  XW_HandleBinaryMessageCallback handle_binary_msg_callback_;
+  XW_HandleBinaryMessageCallback handle_binary_sync_msg_callback_;
 };
 
 }  // namespace extensions
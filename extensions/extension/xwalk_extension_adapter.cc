@@ -104,6 +104,32 @@ const void* XWalkExtensionAdapter::GetInterface(const char* name) {
     return &syncMessagingInterface1;
   }
 
+  if (!strcmp(name, XW_INTERNAL_ASYNC_MESSAGING_INTERFACE_1)) {
+    static const XW_Internal_AsyncMessagingInterface_1
+        asyncMessagingInterface1 = {
+      AsyncMessagingRegister,
+      AsyncMessagingSetAsyncReply
+    };
+    return &asyncMessagingInterface1;
+  }
+
+  if (!strcmp(name, XW_INTERNAL_BINARY_MESSAGING_INTERFACE_1)) {
+    static const XW_Internal_BinaryMessagingInterface_1
+        binaryMessagingInterface1 = {
+      BinaryMessagingRegister
+    };
+    return &binaryMessagingInterface1;
+  }
+
+  if (!strcmp(name, XW_INTERNAL_PROPERTY_CACHE_INTERFACE_1)) {
+    static const XW_Internal_PropertyCacheInterface_1
+        propertyCacheInterface1 = {
+      PropertyCacheSetProperty,
+      PropertyCacheInvalidateProperty
+    };
+    return &propertyCacheInterface1;
+  }
+
   if (!strcmp(name, XW_INTERNAL_ENTRY_POINTS_INTERFACE_1)) {
     static const XW_Internal_EntryPointsInterface_1 entryPointsInterface1 = {
       EntryPointsSetExtraJSEntryPoints
@@ -246,6 +272,52 @@ void XWalkExtensionAdapter::SyncMessagingSetSyncReply(
   instance->SyncReplyToJS(reply);
 }
 
+void XWalkExtensionAdapter::AsyncMessagingRegister(
+    XW_Extension xw_extension,
+    XW_HandleAsyncMessageCallback handle_async_message) {
+  XWalkExtension* extension = GetExtension(xw_extension);
+  CHECK(extension, xw_extension);
+  RETURN_IF_INITIALIZED(extension);
+  extension->handle_async_msg_callback_ = handle_async_message;
+}
+
+void XWalkExtensionAdapter::AsyncMessagingSetAsyncReply(
+    XW_Instance xw_instance,
+    int32_t request_id,
+    const char* reply) {
+  XWalkExtensionInstance* instance = GetExtensionInstance(xw_instance);
+  CHECK(instance, xw_instance);
+  instance->AsyncReplyToJS(request_id, reply, true);
+}
+
+void XWalkExtensionAdapter::BinaryMessagingRegister(
+    XW_Extension xw_extension,
+    XW_HandleBinaryMessageCallback handle_message,
+    XW_HandleBinaryMessageCallback handle_sync_message) {
+  XWalkExtension* extension = GetExtension(xw_extension);
+  CHECK(extension, xw_extension);
+  RETURN_IF_INITIALIZED(extension);
+  extension->handle_binary_msg_callback_ = handle_message;
+  extension->handle_binary_sync_msg_callback_ = handle_sync_message;
+}
+
+void XWalkExtensionAdapter::PropertyCacheSetProperty(
+    XW_Instance xw_instance,
+    const char* name,
+    const char* value) {
+  XWalkExtensionInstance* instance = GetExtensionInstance(xw_instance);
+  CHECK(instance, xw_instance);
+  instance->PropertyChangedToJS(name, value, true);
+}
+
+void XWalkExtensionAdapter::PropertyCacheInvalidateProperty(
+    XW_Instance xw_instance,
+    const char* name) {
+  XWalkExtensionInstance* instance = GetExtensionInstance(xw_instance);
+  CHECK(instance, xw_instance);
+  instance->PropertyChangedToJS(name, std::string(), false);
+}
+
 void XWalkExtensionAdapter::EntryPointsSetExtraJSEntryPoints(
     XW_Extension xw_extension,
     const char** entry_points) {
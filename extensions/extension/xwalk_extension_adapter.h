@@ -11,8 +11,11 @@
 #include "extensions/extension/xwalk_extension.h"
 #include "extensions/extension/xwalk_extension_instance.h"
 #include "extensions/public/XW_Extension.h"
+#include "extensions/public/XW_Extension_AsyncMessage.h"
+#include "extensions/public/XW_Extension_BinaryMessage.h"
 #include "extensions/public/XW_Extension_EntryPoints.h"
 #include "extensions/public/XW_Extension_Permissions.h"
+#include "extensions/public/XW_Extension_PropertyCache.h"
 #include "extensions/public/XW_Extension_Runtime.h"
 #include "extensions/public/XW_Extension_SyncMessage.h"
 
@@ -69,6 +72,19 @@ class XWalkExtensionAdapter {
       XW_HandleSyncMessageCallback handle_sync_message);
   static void SyncMessagingSetSyncReply(
       XW_Instance xw_instance, const char* reply);
+  static void AsyncMessagingRegister(
+      XW_Extension xw_extension,
+      XW_HandleAsyncMessageCallback handle_async_message);
+  static void AsyncMessagingSetAsyncReply(
+      XW_Instance xw_instance, int32_t request_id, const char* reply);
+  static void BinaryMessagingRegister(
+      XW_Extension xw_extension,
+      XW_HandleBinaryMessageCallback handle_message,
+      XW_HandleBinaryMessageCallback handle_sync_message);
+  static void PropertyCacheSetProperty(
+      XW_Instance xw_instance, const char* name, const char* value);
+  static void PropertyCacheInvalidateProperty(
+      XW_Instance xw_instance, const char* name);
   static void EntryPointsSetExtraJSEntryPoints(
       XW_Extension xw_extension, const char** entry_points);
   static void RuntimeGetStringVariable(
@@ -5,7 +5,10 @@
 
 #include "extensions/extension/xwalk_extension_instance.h"
 
+#include "common/logger.h"
+#include "extensions/common/binary_message.h"
 #include "extensions/extension/xwalk_extension_adapter.h"
+#include "extensions/public/XW_Extension_AsyncMessage.h"
 #include "extensions/public/XW_Extension_SyncMessage.h"
 
 namespace extensions {
@@ -16,6 +19,9 @@ XWalkExtensionInstance::XWalkExtensionInstance(
     xw_instance_(xw_instance),
     instance_data_(NULL) {
   XWalkExtensionAdapter::GetInstance()->RegisterInstance(this);
+}
+
+void XWalkExtensionInstance::Initialize() {
   XW_CreatedInstanceCallback callback = extension_->created_instance_callback_;
   if (callback)
     callback(xw_instance_);
@@ -42,6 +48,78 @@ void XWalkExtensionInstance::HandleSyncMessage(const std::string& msg) {
   }
 }
 
+void XWalkExtensionInstance::HandleBinaryMessage(const uint8_t* data,
+                                                 size_t size) {
+  XW_HandleBinaryMessageCallback callback =
+      extension_->handle_binary_msg_callback_;
+  if (callback) {
+    callback(xw_instance_, data, size);
+    return;
+  }
+
+  std::string json;
+  if (!BinaryMessageToJSON(data, size, &json)) {
+    LOGGER(ERROR) << "Ignoring malformed binary message.";
+    return;
+  }
+  HandleMessage(json);
+}
+
+void XWalkExtensionInstance::HandleBinarySyncMessage(const uint8_t* data,
+                                                     size_t size) {
+  XW_HandleBinaryMessageCallback callback =
+      extension_->handle_binary_sync_msg_callback_;
+  if (callback) {
+    callback(xw_instance_, data, size);
+    return;
+  }
+
+  std::string json;
+  if (!BinaryMessageToJSON(data, size, &json)) {
+    LOGGER(ERROR) << "Ignoring malformed binary message.";
+    SyncReplyToJS(std::string());
+    return;
+  }
+  HandleSyncMessage(json);
+}
+
+void XWalkExtensionInstance::HandleAsyncMessage(int32_t request_id,
+                                                const std::string& msg) {
+  XW_HandleAsyncMessageCallback callback =
+      extension_->handle_async_msg_callback_;
+  if (callback) {
+    callback(xw_instance_, request_id, msg.c_str());
+    return;
+  }
+
+  // Extensions that only know the sync messaging interface still answer
+  // through SetSyncReply, so route that reply to the pending request while
+  // their handler runs.
+  XW_HandleSyncMessageCallback sync_callback =
+      extension_->handle_sync_msg_callback_;
+  if (!sync_callback) {
+    AsyncReplyToJS(request_id, std::string(), false);
+    return;
+  }
+
+  AsyncReplyCallback async_reply = async_reply_callback_;
+  bool replied = false;
+  MessageCallback sync_reply = send_sync_reply_callback_;
+  send_sync_reply_callback_ = [async_reply, request_id, &replied](
+      const std::string& reply) {
+    replied = true;
+    if (async_reply)
+      async_reply(request_id, reply, true);
+  };
+  sync_callback(xw_instance_, msg.c_str());
+  send_sync_reply_callback_ = sync_reply;
+
+  if (!replied) {
+    LOGGER(WARN) << "No reply to async request " << request_id;
+    AsyncReplyToJS(request_id, std::string(), false);
+  }
+}
+
 void XWalkExtensionInstance::SetPostMessageCallback(
     MessageCallback callback) {
   post_message_callback_ = callback;
@@ -52,6 +130,16 @@ void XWalkExtensionInstance::SetSendSyncReplyCallback(
   send_sync_reply_callback_ = callback;
 }
 
+void XWalkExtensionInstance::SetAsyncReplyCallback(
+    AsyncReplyCallback callback) {
+  async_reply_callback_ = callback;
+}
+
+void XWalkExtensionInstance::SetPropertyChangedCallback(
+    PropertyCallback callback) {
+  property_changed_callback_ = callback;
+}
+
 void XWalkExtensionInstance::PostMessageToJS(const std::string& msg) {
   post_message_callback_(msg);
 }
@@ -60,4 +148,22 @@ void XWalkExtensionInstance::SyncReplyToJS(const std::string& reply) {
   send_sync_reply_callback_(reply);
 }
 
+void XWalkExtensionInstance::AsyncReplyToJS(int32_t request_id,
+                                            const std::string& reply,
+                                            bool ok) {
+  if (async_reply_callback_)
+    async_reply_callback_(request_id, reply, ok);
+}
+
+void XWalkExtensionInstance::PropertyChangedToJS(const std::string& name,
+                                                 const std::string& value,
+                                                 bool valid) {
+  if (valid)
+    properties_[name] = value;
+  else
+    properties_.erase(name);
+  if (property_changed_callback_)
+    property_changed_callback_(name, value, valid);
+}
+
 }  // namespace extensions
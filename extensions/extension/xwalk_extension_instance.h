@@ -6,7 +6,11 @@
 #ifndef XWALK_EXTENSIONS_XWALK_EXTENSION_INSTANCE_H_
 #define XWALK_EXTENSIONS_XWALK_EXTENSION_INSTANCE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <functional>
+#include <map>
 #include <string>
 
 #include "extensions/public/XW_Extension.h"
@@ -18,21 +22,45 @@ class XWalkExtension;
 class XWalkExtensionInstance {
  public:
   typedef std::function<void(const std::string&)> MessageCallback;
+  // |ok| is false when the request failed without a reply.
+  typedef std::function<void(int32_t request_id,
+                             const std::string& reply,
+                             bool ok)> AsyncReplyCallback;
+  typedef std::function<void(const std::string& name,
+                             const std::string& value,
+                             bool valid)> PropertyCallback;
+
+  typedef std::map<std::string, std::string> PropertyMap;
 
   XWalkExtensionInstance(XWalkExtension* extension, XW_Instance xw_instance);
   virtual ~XWalkExtensionInstance();
 
+  // Runs the extension's instance created callback. The callbacks below
+  // should be set before, so that nothing it publishes is lost.
+  void Initialize();
+
   void HandleMessage(const std::string& msg);
   void HandleSyncMessage(const std::string& msg);
+  void HandleAsyncMessage(int32_t request_id, const std::string& msg);
+  void HandleBinaryMessage(const uint8_t* data, size_t size);
+  void HandleBinarySyncMessage(const uint8_t* data, size_t size);
 
   void SetPostMessageCallback(MessageCallback callback);
   void SetSendSyncReplyCallback(MessageCallback callback);
+  void SetAsyncReplyCallback(AsyncReplyCallback callback);
+  void SetPropertyChangedCallback(PropertyCallback callback);
+
+  // Properties published by the extension and not invalidated since.
+  const PropertyMap& properties() const { return properties_; }
 
  private:
   friend class XWalkExtensionAdapter;
 
   void PostMessageToJS(const std::string& msg);
   void SyncReplyToJS(const std::string& reply);
+  void AsyncReplyToJS(int32_t request_id, const std::string& reply, bool ok);
+  void PropertyChangedToJS(const std::string& name, const std::string& value,
+                           bool valid);
 
   XWalkExtension* extension_;
   XW_Instance xw_instance_;
@@ -40,6 +68,9 @@ class XWalkExtensionInstance {
 
   MessageCallback post_message_callback_;
   MessageCallback send_sync_reply_callback_;
+  AsyncReplyCallback async_reply_callback_;
+  PropertyCallback property_changed_callback_;
+  PropertyMap properties_;
 };
 
 }  // namespace extensions
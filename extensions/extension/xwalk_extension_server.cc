@@ -43,6 +43,7 @@ const char kDBusIntrospectionXML[] =
   "    <method name='CreateInstance'>"
   "      <arg name='extension_name' type='s' direction='in' />"
   "      <arg name='instance_id' type='s' direction='out' />"
+  "      <arg name='properties' type='a{ss}' direction='out' />"
   "    </method>"
   "    <method name='DestroyInstance'>"
   "      <arg name='instance_id' type='s' direction='in' />"
@@ -57,10 +58,36 @@ const char kDBusIntrospectionXML[] =
   "      <arg name='msg' type='s' direction='in' />"
   "      <arg name='reply' type='s' direction='out' />"
   "    </method>"
+  "    <method name='PostBinaryMessage'>"
+  "      <arg name='instance_id' type='s' direction='in' />"
+  "      <arg name='msg' type='ay' direction='in' />"
+  "    </method>"
+  "    <method name='SendSyncBinaryMessage'>"
+  "      <arg name='instance_id' type='s' direction='in' />"
+  "      <arg name='msg' type='ay' direction='in' />"
+  "      <arg name='reply' type='s' direction='out' />"
+  "    </method>"
+  "    <method name='SendAsyncMessage'>"
+  "      <arg name='instance_id' type='s' direction='in' />"
+  "      <arg name='request_id' type='i' direction='in' />"
+  "      <arg name='msg' type='s' direction='in' />"
+  "    </method>"
   "    <signal name='OnMessageToJS'>"
   "      <arg name='instance_id' type='s' />"
   "      <arg name='msg' type='s' />"
   "    </signal>"
+  "    <signal name='OnAsyncReplyToJS'>"
+  "      <arg name='instance_id' type='s' />"
+  "      <arg name='request_id' type='i' />"
+  "      <arg name='reply' type='s' />"
+  "      <arg name='ok' type='b' />"
+  "    </signal>"
+  "    <signal name='OnPropertyChangedToJS'>"
+  "      <arg name='instance_id' type='s' />"
+  "      <arg name='name' type='s' />"
+  "      <arg name='value' type='s' />"
+  "      <arg name='valid' type='b' />"
+  "    </signal>"
   "  </interface>"
   "</node>";
 
@@ -290,6 +317,25 @@ void XWalkExtensionServer::HandleDBusMethod(GDBusConnection* connection,
     gchar* msg;
     g_variant_get(parameters, "(&s&s)", &instance_id, &msg);
     OnPostMessage(instance_id, msg);
+  } else if (method_name == kMethodPostBinaryMessage ||
+             method_name == kMethodSendSyncBinaryMessage) {
+    gchar* instance_id;
+    GVariant* msg;
+    g_variant_get(parameters, "(&s@ay)", &instance_id, &msg);
+    gsize size = 0;
+    const uint8_t* data = static_cast<const uint8_t*>(
+        g_variant_get_fixed_array(msg, &size, sizeof(uint8_t)));
+    if (method_name == kMethodPostBinaryMessage)
+      OnPostBinaryMessage(instance_id, data, size);
+    else
+      OnSendSyncBinaryMessage(instance_id, data, size, invocation);
+    g_variant_unref(msg);
+  } else if (method_name == kMethodSendAsyncMessage) {
+    gchar* instance_id;
+    gint32 request_id;
+    gchar* msg;
+    g_variant_get(parameters, "(&si&s)", &instance_id, &request_id, &msg);
+    OnSendAsyncMessage(instance_id, request_id, msg);
   } else if (method_name == kMethodGetJavascriptCode) {
     gchar* extension_name;
     g_variant_get(parameters, "(&s)", &extension_name);
@@ -362,13 +408,32 @@ void XWalkExtensionServer::OnCreateInstance(
 
   // set callbacks
   using std::placeholders::_1;
+  using std::placeholders::_2;
+  using std::placeholders::_3;
   instance->SetPostMessageCallback(
       std::bind(&XWalkExtensionServer::PostMessageToJSCallback,
                 this, connection, instance_id, _1));
+  instance->SetAsyncReplyCallback(
+      std::bind(&XWalkExtensionServer::AsyncReplyToJSCallback,
+                this, connection, instance_id, _1, _2, _3));
+  instance->SetPropertyChangedCallback(
+      std::bind(&XWalkExtensionServer::PropertyChangedToJSCallback,
+                this, connection, instance_id, _1, _2, _3));
+  instance->Initialize();
+
+  // The renderer only handles signals of the instance once it has the id,
+  // so the properties published so far are sent along with it.
+  GVariantBuilder properties;
+  g_variant_builder_init(&properties, G_VARIANT_TYPE("a{ss}"));
+  for (auto& property : instance->properties()) {
+    g_variant_builder_add(&properties, "{ss}", property.first.c_str(),
+                          property.second.c_str());
+  }
 
   instances_[instance_id] = instance;
   g_dbus_method_invocation_return_value(
-      invocation, g_variant_new("(s)", instance_id.c_str()));
+      invocation, g_variant_new("(sa{ss})", instance_id.c_str(),
+                                &properties));
 }
 
 void XWalkExtensionServer::OnDestroyInstance(
@@ -429,6 +494,55 @@ void XWalkExtensionServer::OnPostMessage(
   instance->HandleMessage(msg);
 }
 
+// async
+void XWalkExtensionServer::OnPostBinaryMessage(
+    const std::string& instance_id, const uint8_t* data, size_t size) {
+  auto it = instances_.find(instance_id);
+  if (it == instances_.end()) {
+    LOGGER(ERROR) << "Failed to find instance '" << instance_id << "'";
+    return;
+  }
+
+  XWalkExtensionInstance* instance = it->second;
+  instance->HandleBinaryMessage(data, size);
+}
+
+void XWalkExtensionServer::OnSendSyncBinaryMessage(
+    const std::string& instance_id, const uint8_t* data, size_t size,
+    GDBusMethodInvocation* invocation) {
+  auto it = instances_.find(instance_id);
+  if (it == instances_.end()) {
+    LOGGER(ERROR) << "Failed to find instance '" << instance_id << "'";
+    g_dbus_method_invocation_return_error(
+        invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+        "Not found instance %s", instance_id.c_str());
+    return;
+  }
+
+  XWalkExtensionInstance* instance = it->second;
+
+  using std::placeholders::_1;
+  instance->SetSendSyncReplyCallback(
+      std::bind(&XWalkExtensionServer::SyncReplyCallback,
+                this, _1, invocation));
+
+  instance->HandleBinarySyncMessage(data, size);
+}
+
+// async, the reply is delivered later by the OnAsyncReplyToJS signal
+void XWalkExtensionServer::OnSendAsyncMessage(
+    const std::string& instance_id, int32_t request_id,
+    const std::string& msg) {
+  auto it = instances_.find(instance_id);
+  if (it == instances_.end()) {
+    LOGGER(ERROR) << "Failed to find instance '" << instance_id << "'";
+    return;
+  }
+
+  XWalkExtensionInstance* instance = it->second;
+  instance->HandleAsyncMessage(request_id, msg);
+}
+
 void XWalkExtensionServer::OnGetJavascriptCode(GDBusConnection* connection,
                         const std::string& extension_name,
                         GDBusMethodInvocation* invocation) {
@@ -469,4 +583,40 @@ void XWalkExtensionServer::PostMessageToJSCallback(
                                         msg.c_str()));
 }
 
+void XWalkExtensionServer::AsyncReplyToJSCallback(
+    GDBusConnection* connection, const std::string& instance_id,
+    int32_t request_id, const std::string& reply, bool ok) {
+  if (!connection || g_dbus_connection_is_closed(connection)) {
+    LOGGER(ERROR) << "Client connection is closed already.";
+    return;
+  }
+
+  dbus_server_.SendSignal(connection,
+                          kDBusInterfaceNameForExtension,
+                          kSignalOnAsyncReplyToJS,
+                          g_variant_new("(sisb)",
+                                        instance_id.c_str(),
+                                        request_id,
+                                        reply.c_str(),
+                                        ok));
+}
+
+void XWalkExtensionServer::PropertyChangedToJSCallback(
+    GDBusConnection* connection, const std::string& instance_id,
+    const std::string& name, const std::string& value, bool valid) {
+  if (!connection || g_dbus_connection_is_closed(connection)) {
+    LOGGER(ERROR) << "Client connection is closed already.";
+    return;
+  }
+
+  dbus_server_.SendSignal(connection,
+                          kDBusInterfaceNameForExtension,
+                          kSignalOnPropertyChangedToJS,
+                          g_variant_new("(sssb)",
+                                        instance_id.c_str(),
+                                        name.c_str(),
+                                        value.c_str(),
+                                        valid));
+}
+
 }  // namespace extensions
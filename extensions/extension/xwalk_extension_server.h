@@ -52,6 +52,14 @@ class XWalkExtensionServer : public XWalkExtension::XWalkExtensionDelegate {
                          GDBusMethodInvocation* invocation);
   void OnPostMessage(const std::string& instance_id,
                      const std::string& msg);
+  void OnPostBinaryMessage(const std::string& instance_id,
+                           const uint8_t* data, size_t size);
+  void OnSendSyncBinaryMessage(const std::string& instance_id,
+                               const uint8_t* data, size_t size,
+                               GDBusMethodInvocation* invocation);
+  void OnSendAsyncMessage(const std::string& instance_id,
+                          int32_t request_id,
+                          const std::string& msg);
 
   void SyncReplyCallback(const std::string& reply,
                          GDBusMethodInvocation* invocation);
@@ -59,6 +67,16 @@ class XWalkExtensionServer : public XWalkExtension::XWalkExtensionDelegate {
   void PostMessageToJSCallback(GDBusConnection* connection,
                                const std::string& instance_id,
                                const std::string& msg);
+  void AsyncReplyToJSCallback(GDBusConnection* connection,
+                              const std::string& instance_id,
+                              int32_t request_id,
+                              const std::string& reply,
+                              bool ok);
+  void PropertyChangedToJSCallback(GDBusConnection* connection,
+                                   const std::string& instance_id,
+                                   const std::string& name,
+                                   const std::string& value,
+                                   bool valid);
   void OnGetJavascriptCode(GDBusConnection* connection,
                         const std::string& extension_name,
                         GDBusMethodInvocation* invocation);
@@ -10,6 +10,8 @@
         '../common/common.gyp:xwalk_tizen_common',
       ],
       'sources': [
+        'common/binary_message.h',
+        'common/binary_message.cc',
         'common/constants.h',
         'common/constants.cc',
         'extension/xwalk_extension.h',
@@ -38,6 +40,8 @@
         '../common/common.gyp:xwalk_tizen_common',
       ],
       'sources': [
+        'common/binary_message.h',
+        'common/binary_message.cc',
         'common/constants.h',
         'common/constants.cc',
         'renderer/xwalk_extension_client.h',
@@ -48,6 +52,8 @@
         'renderer/xwalk_extension_renderer_controller.cc',
         'renderer/xwalk_module_system.h',
         'renderer/xwalk_module_system.cc',
+        'renderer/xwalk_string_cache.h',
+        'renderer/xwalk_string_cache.cc',
         'renderer/xwalk_v8tools_module.h',
         'renderer/xwalk_v8tools_module.cc',
         'renderer/widget_module.h',
@@ -84,4 +90,23 @@
       ],
     }, # end of target 'widget_plugin'
   ], # end of targets
+  'conditions': [
+    ['build_benchmarks==1', {
+      'targets': [
+        {
+          'target_name': 'xwalk_binary_message_benchmark',
+          'type': 'executable',
+          'dependencies': [
+            '../common/common.gyp:xwalk_benchmark_utils',
+            '../common/common.gyp:xwalk_tizen_common',
+          ],
+          'sources': [
+            'common/binary_message.h',
+            'common/binary_message.cc',
+            'common/binary_message_benchmark.cc',
+          ],
+        }, # end of target 'xwalk_binary_message_benchmark'
+      ],
+    }],
+  ],
 }
@@ -0,0 +1,56 @@
+// Copyright (c) 2015 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_ASYNCMESSAGE_H_
+#define XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_ASYNCMESSAGE_H_
+
+// NOTE: This file and interfaces marked as internal are not considered stable
+// and can be modified in incompatible ways between Crosswalk versions.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_H_
+#error "You should include XW_Extension.h before this file"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// XW_INTERNAL_ASYNC_MESSAGING_INTERFACE: allow JavaScript code to send a
+// request to extension code and get a Promise that is resolved with the
+// response. Every request carries an id chosen by the runtime, and the
+// response is made available by calling the SetAsyncReply function with the
+// same id. Unlike SetSyncReply, the JavaScript side is not blocked while the
+// request is pending, so several requests can be in flight at once and may
+// be answered in any order.
+//
+// Extensions that don't register a handler for this interface still receive
+// the requests through their XW_HandleSyncMessageCallback, and their
+// SetSyncReply is delivered to JavaScript asynchronously.
+//
+
+#define XW_INTERNAL_ASYNC_MESSAGING_INTERFACE_1 \
+  "XW_InternalAsyncMessagingInterface_1"
+#define XW_INTERNAL_ASYNC_MESSAGING_INTERFACE \
+  XW_INTERNAL_ASYNC_MESSAGING_INTERFACE_1
+
+typedef void (*XW_HandleAsyncMessageCallback)(XW_Instance instance,
+                                              int32_t request_id,
+                                              const char* message);
+
+struct XW_Internal_AsyncMessagingInterface_1 {
+  void (*Register)(XW_Extension extension,
+                   XW_HandleAsyncMessageCallback handle_async_message);
+  void (*SetAsyncReply)(XW_Instance instance, int32_t request_id,
+                        const char* reply);
+};
+
+typedef struct XW_Internal_AsyncMessagingInterface_1
+    XW_Internal_AsyncMessagingInterface;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_ASYNCMESSAGE_H_
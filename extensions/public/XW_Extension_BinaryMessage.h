@@ -0,0 +1,58 @@
+// Copyright (c) 2015 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_BINARYMESSAGE_H_
+#define XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_BINARYMESSAGE_H_
+
+// NOTE: This file and interfaces marked as internal are not considered stable
+// and can be modified in incompatible ways between Crosswalk versions.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_H_
+#error "You should include XW_Extension.h before this file"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// XW_INTERNAL_BINARY_MESSAGING_INTERFACE: receive the messages that
+// JavaScript code sends as plain objects, i.e. extension.postMessage(obj)
+// and extension.internal.sendSyncMessage(obj), in binary form instead of
+// JSON text. The data is a CBOR (RFC 7049) encoding of the object limited to
+// integers, text strings, arrays, maps with text string keys, booleans, null
+// and doubles. It points into the received IPC message and is only valid
+// during the callback, so it can be read in place without copying.
+//
+// Synchronous messages are answered with SetSyncReply of
+// XW_INTERNAL_SYNC_MESSAGING_INTERFACE as usual. Extensions that don't
+// register these handlers get such messages converted to JSON text through
+// their regular message handlers.
+//
+
+#define XW_INTERNAL_BINARY_MESSAGING_INTERFACE_1 \
+  "XW_InternalBinaryMessagingInterface_1"
+#define XW_INTERNAL_BINARY_MESSAGING_INTERFACE \
+  XW_INTERNAL_BINARY_MESSAGING_INTERFACE_1
+
+typedef void (*XW_HandleBinaryMessageCallback)(XW_Instance instance,
+                                               const uint8_t* data,
+                                               size_t size);
+
+struct XW_Internal_BinaryMessagingInterface_1 {
+  void (*Register)(XW_Extension extension,
+                   XW_HandleBinaryMessageCallback handle_message,
+                   XW_HandleBinaryMessageCallback handle_sync_message);
+};
+
+typedef struct XW_Internal_BinaryMessagingInterface_1
+    XW_Internal_BinaryMessagingInterface;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_BINARYMESSAGE_H_
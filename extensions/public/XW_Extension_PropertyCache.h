@@ -0,0 +1,48 @@
+// Copyright (c) 2015 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_PROPERTYCACHE_H_
+#define XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_PROPERTYCACHE_H_
+
+// NOTE: This file and interfaces marked as internal are not considered stable
+// and can be modified in incompatible ways between Crosswalk versions.
+
+#ifndef XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_H_
+#error "You should include XW_Extension.h before this file"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// XW_INTERNAL_PROPERTY_CACHE_INTERFACE: allow extension code to publish
+// named values, e.g. a battery level, to the JavaScript side of an instance.
+// Published values are mirrored in the renderer and read there with
+// extension.getProperty(name) without a round trip to the extension. The
+// extension calls SetProperty whenever the value changes, and
+// InvalidateProperty when it can no longer be served from the cache, in
+// which case getProperty() returns undefined and the JavaScript code is
+// expected to fall back to asking the extension.
+//
+
+#define XW_INTERNAL_PROPERTY_CACHE_INTERFACE_1 \
+  "XW_InternalPropertyCacheInterface_1"
+#define XW_INTERNAL_PROPERTY_CACHE_INTERFACE \
+  XW_INTERNAL_PROPERTY_CACHE_INTERFACE_1
+
+struct XW_Internal_PropertyCacheInterface_1 {
+  void (*SetProperty)(XW_Instance instance, const char* name,
+                      const char* value);
+  void (*InvalidateProperty)(XW_Instance instance, const char* name);
+};
+
+typedef struct XW_Internal_PropertyCacheInterface_1
+    XW_Internal_PropertyCacheInterface;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // XWALK_EXTENSIONS_PUBLIC_XW_EXTENSION_PROPERTYCACHE_H_
@@ -23,6 +23,7 @@
 
 #include "common/app_db.h"
 #include "common/logger.h"
+#include "extensions/renderer/xwalk_string_cache.h"
 
 namespace extensions {
 
@@ -34,6 +35,15 @@ const char* kSetItemKey = "setItem";
 const char* kRemoveItemKey = "removeItem";
 const char* kLengthKey = "length";
 const char* kClearKey = "clear";
+const char* kPreferenceKey = "preference";
+const char* kAuthorKey = "author";
+const char* kDescriptionKey = "description";
+const char* kNameKey = "name";
+const char* kShortNameKey = "shortName";
+const char* kVersionKey = "version";
+const char* kIdKey = "id";
+const char* kAuthorEmailKey = "authorEmail";
+const char* kAuthorHrefKey = "authorHref";
 const int kKeyLengthLimit = 80;
 const int kValueLengthLimit = 8192;
 
@@ -52,8 +62,8 @@ void DispatchEvent(const v8::Local<v8::Object>& This,
                    v8::Local<v8::Value> newvalue) {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
 
-  v8::Handle<v8::Value> function =
-      This->Get(v8::String::NewFromUtf8(isolate, kOnchangedEventHandler));
+  v8::Handle<v8::Value> function = This->Get(
+      XWalkStringCache::GetInstance(isolate)->Get(kOnchangedEventHandler));
 
   if (function.IsEmpty() || !function->IsFunction()) {
     LOGGER(DEBUG) << "onChanged function not set";
@@ -186,6 +196,7 @@ void ClearFunction(const v8::FunctionCallbackInfo<v8::Value>& info) {
 WidgetModule::WidgetModule() {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
+  XWalkStringCache* strings = XWalkStringCache::GetInstance(isolate);
   v8::Handle<v8::ObjectTemplate>
       preference_object_template = v8::ObjectTemplate::New();
 
@@ -283,23 +294,23 @@ WidgetModule::WidgetModule() {
       NULL);
 
   preference_object_template->Set(
-      v8::String::NewFromUtf8(isolate, kKeyKey),
+      strings->Get(kKeyKey),
       v8::FunctionTemplate::New(isolate, KeyFunction));
 
   preference_object_template->Set(
-      v8::String::NewFromUtf8(isolate, kGetItemKey),
+      strings->Get(kGetItemKey),
       v8::FunctionTemplate::New(isolate, GetItemFunction));
 
   preference_object_template->Set(
-      v8::String::NewFromUtf8(isolate, kSetItemKey),
+      strings->Get(kSetItemKey),
       v8::FunctionTemplate::New(isolate, SetItemFunction));
 
   preference_object_template->Set(
-      v8::String::NewFromUtf8(isolate, kRemoveItemKey),
+      strings->Get(kRemoveItemKey),
       v8::FunctionTemplate::New(isolate, RemoveItemFunction));
 
   preference_object_template->Set(
-      v8::String::NewFromUtf8(isolate, kClearKey),
+      strings->Get(kClearKey),
       v8::FunctionTemplate::New(isolate, ClearFunction));
 
 
@@ -320,33 +331,32 @@ v8::Handle<v8::Object> WidgetModule::NewInstance() {
   auto widgetdb = WidgetPreferenceDB::GetInstance();
   widgetdb->InitializeDB();
 
-  widget->Set(
-      v8::String::NewFromUtf8(isolate, "preference"),
-      object_template->NewInstance());
+  XWalkStringCache* strings = XWalkStringCache::GetInstance(isolate);
+  widget->Set(strings->Get(kPreferenceKey), object_template->NewInstance());
 
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "author"),
+      strings->Get(kAuthorKey),
       v8::String::NewFromUtf8(isolate, widgetdb->author().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "description"),
+      strings->Get(kDescriptionKey),
       v8::String::NewFromUtf8(isolate, widgetdb->description().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "name"),
+      strings->Get(kNameKey),
       v8::String::NewFromUtf8(isolate, widgetdb->name().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "shortName"),
+      strings->Get(kShortNameKey),
       v8::String::NewFromUtf8(isolate, widgetdb->shortName().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "version"),
+      strings->Get(kVersionKey),
       v8::String::NewFromUtf8(isolate, widgetdb->version().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "id"),
+      strings->Get(kIdKey),
       v8::String::NewFromUtf8(isolate, widgetdb->id().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "authorEmail"),
+      strings->Get(kAuthorEmailKey),
       v8::String::NewFromUtf8(isolate, widgetdb->authorEmail().c_str()));
   widget->Set(
-      v8::String::NewFromUtf8(isolate, "authorHref"),
+      strings->Get(kAuthorHrefKey),
       v8::String::NewFromUtf8(isolate, widgetdb->authorHref().c_str()));
 
   return handle_scope.Escape(widget);
@@ -366,7 +376,12 @@ WidgetPreferenceDB* WidgetPreferenceDB::GetInstance() {
   return &instance;
 }
 
-WidgetPreferenceDB::WidgetPreferenceDB() {
+WidgetPreferenceDB::WidgetPreferenceDB()
+    : appdata_(NULL),
+      locale_manager_(NULL),
+      cache_loaded_(false),
+      cache_version_(0),
+      keys_valid_(false) {
 }
 WidgetPreferenceDB::~WidgetPreferenceDB() {
 }
@@ -388,6 +403,10 @@ void WidgetPreferenceDB::InitializeDB() {
   }
 
   auto& preferences = appdata_->widget_info()->preferences();
+  common::AppDB::ValueMap existing;
+  db->GetAll(kDBPublicSection, &existing);
+  common::AppDB::ValueMap public_values;
+  common::AppDB::ValueMap private_values;
 
   for (const auto& pref : preferences) {
     if (pref->Name().empty())
@@ -400,7 +419,8 @@ void WidgetPreferenceDB::InitializeDB() {
       key.resize(kKeyLengthLimit);
     }
 
-    if (db->HasKey(kDBPublicSection, key))
+    if (existing.find(key) != existing.end() ||
+        public_values.find(key) != public_values.end())
       continue;
 
     // check size limit
@@ -408,87 +428,130 @@ void WidgetPreferenceDB::InitializeDB() {
       value.resize(kValueLengthLimit);
     }
 
-    db->Set(kDBPublicSection,
-            key,
-            value);
+    public_values[key] = value;
     if (pref->ReadOnly()) {
-      db->Set(kDBPrivateSection,
-              kReadOnlyPrefix + key, "true");
+      private_values[kReadOnlyPrefix + key] = "true";
     }
   }
-  db->Set(kDBPrivateSection, kDbInitedCheckKey, "true");
+  private_values[kDbInitedCheckKey] = "true";
+
+  common::AppDB::Transaction transaction(db);
+  db->SetMany(kDBPublicSection, public_values);
+  db->SetMany(kDBPrivateSection, private_values);
+  cache_loaded_ = false;
 }
 
 int WidgetPreferenceDB::Length() {
-  common::AppDB* db = common::AppDB::GetInstance();
-  std::list<std::string> list;
-  db->GetKeys(kDBPublicSection, &list);
-  return list.size();
+  EnsureCacheValid();
+  return items_.size();
 }
 
 bool WidgetPreferenceDB::Key(int idx, std::string* key) {
-  common::AppDB* db = common::AppDB::GetInstance();
-  std::list<std::string> list;
-  db->GetKeys(kDBPublicSection, &list);
-
-  auto it = list.begin();
-  for ( ; it != list.end() && idx >= 0; ++it) {
-    if (idx == 0) {
-      *key = *it;
-      return true;
-    }
-    idx--;
+  EnsureCacheValid();
+  if (idx < 0 || static_cast<size_t>(idx) >= items_.size())
+    return false;
+
+  if (!keys_valid_) {
+    keys_.clear();
+    keys_.reserve(items_.size());
+    for (auto it = items_.begin(); it != items_.end(); ++it)
+      keys_.push_back(it->first);
+    keys_valid_ = true;
   }
-  return false;
+  *key = keys_[idx];
+  return true;
 }
 
 bool WidgetPreferenceDB::GetItem(const std::string& key, std::string* value) {
-  common::AppDB* db = common::AppDB::GetInstance();
-  if (!db->HasKey(kDBPublicSection, key))
+  EnsureCacheValid();
+  auto it = items_.find(key);
+  if (it == items_.end())
     return false;
-  *value = db->Get(kDBPublicSection, key);
+  *value = it->second;
   return true;
 }
 
 bool WidgetPreferenceDB::SetItem(const std::string& key,
                                  const std::string& value) {
-  common::AppDB* db = common::AppDB::GetInstance();
-  if (db->HasKey(kDBPrivateSection, kReadOnlyPrefix + key))
+  EnsureCacheValid();
+  if (readonly_keys_.find(key) != readonly_keys_.end())
     return false;
-  db->Set(kDBPublicSection, key, value);
+  common::AppDB::GetInstance()->Set(kDBPublicSection, key, value);
+  auto inserted = items_.insert(std::make_pair(key, value));
+  if (inserted.second)
+    keys_valid_ = false;
+  else
+    inserted.first->second = value;
   return true;
 }
 
 bool WidgetPreferenceDB::RemoveItem(const std::string& key) {
-  common::AppDB* db = common::AppDB::GetInstance();
-  if (!db->HasKey(kDBPublicSection, key))
+  EnsureCacheValid();
+  auto it = items_.find(key);
+  if (it == items_.end())
     return false;
-  if (db->HasKey(kDBPrivateSection, kReadOnlyPrefix + key))
+  if (readonly_keys_.find(key) != readonly_keys_.end())
     return false;
-  db->Remove(kDBPublicSection, key);
+  common::AppDB::GetInstance()->Remove(kDBPublicSection, key);
+  items_.erase(it);
+  keys_valid_ = false;
   return true;
 }
 
 bool WidgetPreferenceDB::HasItem(const std::string& key) {
-  common::AppDB* db = common::AppDB::GetInstance();
-  return db->HasKey(kDBPublicSection, key);
+  EnsureCacheValid();
+  return items_.find(key) != items_.end();
 }
 
 void WidgetPreferenceDB::Clear() {
-  common::AppDB* db = common::AppDB::GetInstance();
-  std::list<std::string> list;
-  db->GetKeys(kDBPublicSection, &list);
-  auto it = list.begin();
-  for ( ; it != list.end(); ++it) {
-    if (db->HasKey(kDBPrivateSection, kReadOnlyPrefix + *it))
+  EnsureCacheValid();
+  std::list<std::string> removed;
+  auto it = items_.begin();
+  while (it != items_.end()) {
+    if (readonly_keys_.find(it->first) != readonly_keys_.end()) {
+      ++it;
       continue;
-    db->Remove(kDBPublicSection, *it);
+    }
+    removed.push_back(it->first);
+    items_.erase(it++);
   }
+  common::AppDB::GetInstance()->RemoveMany(kDBPublicSection, removed);
+  keys_valid_ = false;
 }
 
 void WidgetPreferenceDB::GetKeys(std::list<std::string>* keys) {
+  EnsureCacheValid();
+  for (auto it = items_.begin(); it != items_.end(); ++it) {
+    keys->push_back(it->first);
+  }
+}
+
+void WidgetPreferenceDB::EnsureCacheValid() {
+  int version = common::AppDB::GetInstance()->DataVersion();
+  if (cache_loaded_ && version == cache_version_)
+    return;
+
+  cache_version_ = version;
+  LoadCache();
+}
+
+void WidgetPreferenceDB::LoadCache() {
   common::AppDB* db = common::AppDB::GetInstance();
-  db->GetKeys(kDBPublicSection, keys);
+
+  items_.clear();
+  db->GetAll(kDBPublicSection, &items_);
+
+  readonly_keys_.clear();
+  std::string prefix(kReadOnlyPrefix);
+  std::list<std::string> private_keys;
+  db->GetKeys(kDBPrivateSection, &private_keys);
+  for (auto it = private_keys.begin(); it != private_keys.end(); ++it) {
+    if (it->compare(0, prefix.size(), prefix) == 0)
+      readonly_keys_.insert(it->substr(prefix.size()));
+  }
+
+  keys_valid_ = false;
+  cache_loaded_ = true;
 }
 
 std::string WidgetPreferenceDB::author() {
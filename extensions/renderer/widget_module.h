@@ -18,7 +18,10 @@
 #define XWALK_EXTENSIONS_RENDERER_WIDGET_MODULE_H_
 
 #include <list>
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "common/application_data.h"
 #include "common/locale_manager.h"
@@ -66,8 +69,27 @@ class WidgetPreferenceDB {
  private:
   WidgetPreferenceDB();
   virtual ~WidgetPreferenceDB();
+
+  // Preferences are served from an in-memory copy of the DB, which is
+  // loaded again when AppDB::DataVersion() reports that another process
+  // wrote to the DB. Changes are made to the copy and the DB together, the
+  // DB buffers and writes them itself.
+  void EnsureCacheValid();
+  void LoadCache();
+
   const common::ApplicationData* appdata_;
   common::LocaleManager* locale_manager_;
+
+  bool cache_loaded_;
+  int cache_version_;
+  std::map<std::string, std::string> items_;
+  std::set<std::string> readonly_keys_;
+  // Keys of |items_| in order, built on the first Key() call after a key was
+  // added or removed. Keys are enumerated in byte order, which is also the
+  // order of the (section, key) primary key the SQLite DB used to list
+  // them by.
+  std::vector<std::string> keys_;
+  bool keys_valid_;
 };
 
 }  // namespace extensions
@@ -32,7 +32,7 @@ std::string XWalkExtensionClient::CreateInstance(
   GVariant* value = dbus_extension_client_.Call(
       kDBusInterfaceNameForExtension, kMethodCreateInstance,
       g_variant_new("(s)", extension_name.c_str()),
-      G_VARIANT_TYPE("(s)"));
+      G_VARIANT_TYPE("(sa{ss})"));
 
   if (!value) {
     LOGGER(ERROR) << "Failed to create instance for extension "
@@ -41,11 +41,19 @@ std::string XWalkExtensionClient::CreateInstance(
   }
 
   gchar* instance_id;
-  g_variant_get(value, "(&s)", &instance_id);
+  GVariantIter* properties;
+  g_variant_get(value, "(&sa{ss})", &instance_id, &properties);
 
   std::string ret(instance_id);
   handlers_[ret] = handler;
 
+  // Properties the instance published while it was created
+  gchar* name;
+  gchar* property;
+  while (g_variant_iter_loop(properties, "{&s&s}", &name, &property))
+    handler->HandlePropertyFromNative(name, property, true);
+  g_variant_iter_free(properties);
+
   g_variant_unref(value);
   return ret;
 }
@@ -98,6 +106,48 @@ std::string XWalkExtensionClient::SendSyncMessageToNative(
   return ret;
 }
 
+void XWalkExtensionClient::PostBinaryMessageToNative(
+    const std::string& instance_id, const std::vector<uint8_t>& msg) {
+  dbus_extension_client_.Call(
+      kDBusInterfaceNameForExtension, kMethodPostBinaryMessage,
+      g_variant_new("(s@ay)", instance_id.c_str(),
+                    g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, msg.data(),
+                                              msg.size(), sizeof(uint8_t))),
+      NULL);
+}
+
+std::string XWalkExtensionClient::SendSyncBinaryMessageToNative(
+    const std::string& instance_id, const std::vector<uint8_t>& msg) {
+  GVariant* value = dbus_extension_client_.Call(
+      kDBusInterfaceNameForExtension, kMethodSendSyncBinaryMessage,
+      g_variant_new("(s@ay)", instance_id.c_str(),
+                    g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, msg.data(),
+                                              msg.size(), sizeof(uint8_t))),
+      G_VARIANT_TYPE("(s)"));
+
+  if (!value) {
+    LOGGER(ERROR) << "Failed to send synchronous message to ExtensionServer.";
+    return std::string();
+  }
+
+  gchar* reply;
+  g_variant_get(value, "(&s)", &reply);
+
+  std::string ret(reply);
+  g_variant_unref(value);
+
+  return ret;
+}
+
+void XWalkExtensionClient::SendAsyncMessageToNative(
+    const std::string& instance_id, int32_t request_id,
+    const std::string& msg) {
+  dbus_extension_client_.Call(
+      kDBusInterfaceNameForExtension, kMethodSendAsyncMessage,
+      g_variant_new("(sis)", instance_id.c_str(), request_id, msg.c_str()),
+      NULL);
+}
+
 bool XWalkExtensionClient::Initialize(const std::string& appid) {
   STEP_PROFILE_START("Connect ExtensionServer");
   // Retry connecting to ExtensionServer
@@ -168,7 +218,36 @@ void XWalkExtensionClient::HandleSignal(
     if (it != handlers_.end()) {
       InstanceHandler* handler = it->second;
       if (handler) {
-        handler->HandleMessageFromNative(msg);
+        std::string message(msg);
+        handler->HandleMessageFromNative(&message);
+      }
+    }
+  } else if (signal_name == kSignalOnAsyncReplyToJS) {
+    gchar* instance_id;
+    gint32 request_id;
+    gchar* reply;
+    gboolean ok;
+    g_variant_get(parameters, "(&si&sb)", &instance_id, &request_id, &reply,
+                  &ok);
+    auto it = handlers_.find(instance_id);
+    if (it != handlers_.end()) {
+      InstanceHandler* handler = it->second;
+      if (handler) {
+        std::string message(reply);
+        handler->HandleAsyncReplyFromNative(request_id, &message, ok);
+      }
+    }
+  } else if (signal_name == kSignalOnPropertyChangedToJS) {
+    gchar* instance_id;
+    gchar* name;
+    gchar* value;
+    gboolean valid;
+    g_variant_get(parameters, "(&s&s&sb)", &instance_id, &name, &value, &valid);
+    auto it = handlers_.find(instance_id);
+    if (it != handlers_.end()) {
+      InstanceHandler* handler = it->second;
+      if (handler) {
+        handler->HandlePropertyFromNative(name, value, valid);
       }
     }
   }
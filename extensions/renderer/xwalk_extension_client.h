@@ -6,6 +6,8 @@
 #ifndef XWALK_EXTENSIONS_RENDERER_XWALK_EXTENSION_CLIENT_H_
 #define XWALK_EXTENSIONS_RENDERER_XWALK_EXTENSION_CLIENT_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
@@ -18,7 +20,16 @@ namespace extensions {
 class XWalkExtensionClient {
  public:
   struct InstanceHandler {
-    virtual void HandleMessageFromNative(const std::string& msg) = 0;
+    // The handlers may take the contents of |msg| and |reply|, so that
+    // large messages reach V8 without being copied again.
+    virtual void HandleMessageFromNative(std::string* msg) = 0;
+    // |ok| is false when the request failed without a reply.
+    virtual void HandleAsyncReplyFromNative(int32_t request_id,
+                                            std::string* reply,
+                                            bool ok) = 0;
+    virtual void HandlePropertyFromNative(const std::string& name,
+                                          const std::string& value,
+                                          bool valid) = 0;
    protected:
     ~InstanceHandler() {}
   };
@@ -34,6 +45,13 @@ class XWalkExtensionClient {
                            const std::string& msg);
   std::string SendSyncMessageToNative(const std::string& instance_id,
                                       const std::string& msg);
+  void PostBinaryMessageToNative(const std::string& instance_id,
+                                 const std::vector<uint8_t>& msg);
+  std::string SendSyncBinaryMessageToNative(const std::string& instance_id,
+                                            const std::vector<uint8_t>& msg);
+  void SendAsyncMessageToNative(const std::string& instance_id,
+                                int32_t request_id,
+                                const std::string& msg);
 
   bool Initialize(const std::string& appid);
 
@@ -10,12 +10,15 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include <cmath>
 #include <vector>
 
 #include "common/logger.h"
+#include "extensions/common/binary_message.h"
 #include "extensions/renderer/runtime_ipc_client.h"
 #include "extensions/renderer/xwalk_extension_client.h"
 #include "extensions/renderer/xwalk_module_system.h"
+#include "extensions/renderer/xwalk_string_cache.h"
 
 // The arraysize(arr) macro returns the # of elements in an array arr.
 // The expression is a compile-time constant, and therefore can be
@@ -44,20 +47,34 @@ namespace {
 // pointer back to kXWalkExtensionModule.
 const char* kXWalkExtensionModule = "kXWalkExtensionModule";
 
+// Names of the functions exposed in the 'extension' object.
+const char* kPostMessageKey = "postMessage";
+const char* kSendSyncMessageKey = "sendSyncMessage";
+const char* kSendMessageAsyncKey = "sendMessageAsync";
+const char* kSetMessageListenerKey = "setMessageListener";
+const char* kGetPropertyKey = "getProperty";
+const char* kSendRuntimeMessageKey = "sendRuntimeMessage";
+const char* kSendRuntimeSyncMessageKey = "sendRuntimeSyncMessage";
+const char* kSendRuntimeAsyncMessageKey = "sendRuntimeAsyncMessage";
+
 }  // namespace
 
 XWalkExtensionModule::XWalkExtensionModule(XWalkExtensionClient* client,
                                            XWalkModuleSystem* module_system,
                                            const std::string& extension_name,
                                            const std::string& extension_code)
-    : extension_name_(extension_name),
+    : batch_messages_(false),
+      flush_source_id_(0),
+      extension_name_(extension_name),
       extension_code_(extension_code),
       client_(client),
-      module_system_(module_system) {
+      module_system_(module_system),
+      next_request_id_(0) {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
+  XWalkStringCache* strings = XWalkStringCache::GetInstance(isolate);
   v8::Handle<v8::Object> function_data = v8::Object::New(isolate);
-  function_data->Set(v8::String::NewFromUtf8(isolate, kXWalkExtensionModule),
+  function_data->Set(strings->Get(kXWalkExtensionModule),
                      v8::External::New(isolate, this));
 
   v8::Handle<v8::ObjectTemplate> object_template =
@@ -65,26 +82,33 @@ XWalkExtensionModule::XWalkExtensionModule(XWalkExtensionClient* client,
   // TODO(cmarcelo): Use Template::Set() function that takes isolate, once we
   // update the Chromium (and V8) version.
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "postMessage"),
+      strings->Get(kPostMessageKey),
       v8::FunctionTemplate::New(isolate, PostMessageCallback, function_data));
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "sendSyncMessage"),
+      strings->Get(kSendSyncMessageKey),
       v8::FunctionTemplate::New(
           isolate, SendSyncMessageCallback, function_data));
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "setMessageListener"),
+      strings->Get(kSendMessageAsyncKey),
+      v8::FunctionTemplate::New(
+          isolate, SendMessageAsyncCallback, function_data));
+  object_template->Set(
+      strings->Get(kGetPropertyKey),
+      v8::FunctionTemplate::New(isolate, GetPropertyCallback, function_data));
+  object_template->Set(
+      strings->Get(kSetMessageListenerKey),
       v8::FunctionTemplate::New(
           isolate, SetMessageListenerCallback, function_data));
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "sendRuntimeMessage"),
+      strings->Get(kSendRuntimeMessageKey),
       v8::FunctionTemplate::New(
           isolate, SendRuntimeMessageCallback, function_data));
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "sendRuntimeSyncMessage"),
+      strings->Get(kSendRuntimeSyncMessageKey),
       v8::FunctionTemplate::New(
           isolate, SendRuntimeSyncMessageCallback, function_data));
   object_template->Set(
-      v8::String::NewFromUtf8(isolate, "sendRuntimeAsyncMessage"),
+      strings->Get(kSendRuntimeAsyncMessageKey),
       v8::FunctionTemplate::New(
           isolate, SendRuntimeAsyncMessageCallback, function_data));
 
@@ -102,13 +126,23 @@ XWalkExtensionModule::~XWalkExtensionModule() {
   // the iframe), even if we destroy the references we have.
   v8::Handle<v8::Object> function_data =
       v8::Local<v8::Object>::New(isolate, function_data_);
-  function_data->Delete(v8::String::NewFromUtf8(isolate,
-                                                kXWalkExtensionModule));
+  function_data->Delete(
+      XWalkStringCache::GetInstance(isolate)->Get(kXWalkExtensionModule));
 
   object_template_.Reset();
   function_data_.Reset();
   message_listener_.Reset();
 
+  if (flush_source_id_)
+    g_source_remove(flush_source_id_);
+
+  // Requests still in flight are never resolved, the context is going away.
+  for (auto it = pending_replies_.begin(); it != pending_replies_.end(); ++it) {
+    it->second->Reset();
+    delete it->second;
+  }
+  pending_replies_.clear();
+
   if (!instance_id_.empty())
     client_->DestroyInstance(instance_id_);
 }
@@ -205,18 +239,24 @@ std::string WrapAPICode(const std::string& extension_code,
                         const std::string& extension_name) {
   // We take care here to make sure that line numbering for api_code after
   // wrapping doesn't change, so that syntax errors point to the correct line.
-
-  return StringPrintf(
-      "var %s; (function(extension, requireNative) { "
+  static const char kWrapperPrefix[] =
+      " (function(extension, requireNative) { "
       "extension.internal = {};"
       "extension.internal.sendSyncMessage = extension.sendSyncMessage;"
       "delete extension.sendSyncMessage;"
       "var Object = requireNative('objecttools');"
-      "var exports = {}; (function() {'use strict'; %s\n})();"
-      "%s = exports; });",
-      CodeToEnsureNamespace(extension_name).c_str(),
-      extension_code.c_str(),
-      extension_name.c_str());
+      "var exports = {}; (function() {'use strict'; ";
+  static const char kWrapperSuffix[] = "\n})();";
+
+  std::string ns = CodeToEnsureNamespace(extension_name);
+  std::string result;
+  result.reserve(ns.size() + extension_code.size() +
+                 2 * extension_name.size() + sizeof(kWrapperPrefix) +
+                 sizeof(kWrapperSuffix) + 32);
+  result.append("var ").append(ns).append(";").append(kWrapperPrefix);
+  result.append(extension_code).append(kWrapperSuffix);
+  result.append(extension_name).append(" = exports; });");
+  return result;
 }
 
 std::string ExceptionToString(const v8::TryCatch& try_catch) {
@@ -238,12 +278,187 @@ std::string ExceptionToString(const v8::TryCatch& try_catch) {
   return str;
 }
 
-v8::Handle<v8::Value> RunString(const std::string& code,
-                                std::string* exception) {
+// Owns the characters of a string handed to V8 with String::NewExternal, so
+// that V8 reads them in place instead of copying them into its heap. V8
+// deletes the resource once the string is collected.
+class ExternalOneByteString
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit ExternalOneByteString(std::string* data) { data_.swap(*data); }
+  const char* data() const override { return data_.data(); }
+  size_t length() const override { return data_.size(); }
+
+ private:
+  std::string data_;
+};
+
+// Messages shorter than this are cheaper to copy than to track externally.
+const size_t kMinExternalMessageLength = 1024;
+
+bool IsASCII(const std::string& str) {
+  for (auto it = str.begin(); it != str.end(); ++it) {
+    if (static_cast<unsigned char>(*it) >= 0x80)
+      return false;
+  }
+  return true;
+}
+
+// Creates a V8 string from |str|. ASCII strings of at least |min_external|
+// characters are moved into an external string, leaving |str| empty.
+// Anything else is decoded from UTF-8 as before.
+v8::Handle<v8::String> NewV8String(v8::Isolate* isolate, std::string* str,
+                                   size_t min_external) {
+  if (str->size() >= min_external && IsASCII(*str)) {
+    return v8::String::NewExternal(isolate, new ExternalOneByteString(str));
+  }
+  return v8::String::NewFromUtf8(isolate, str->c_str(),
+                                 v8::String::kNormalString, str->size());
+}
+
+// Nesting deeper than this is most likely a cyclic object.
+const int kMaxSerializationDepth = 64;
+
+// What objects are compared against to tell whether they are plain.
+struct PlainObjectCheck {
+  v8::Handle<v8::Value> object_prototype;
+  v8::Handle<v8::String> to_json;
+};
+
+// Arrays and objects made by {} or Object.create(null) are stringified by
+// their own properties. Anything else, like a Date, a String wrapper or an
+// object with toJSON, has its own rules in JSON.stringify.
+bool IsPlainObject(v8::Handle<v8::Object> object,
+                   const PlainObjectCheck& check) {
+  if (object->Has(check.to_json))
+    return false;
+  if (object->IsArray())
+    return true;
+  if (object->IsFunction())
+    return false;
+  v8::Handle<v8::Value> prototype = object->GetPrototype();
+  return prototype->IsNull() || prototype->StrictEquals(check.object_prototype);
+}
+
+// Writes |value| as a binary message, following the rules of JSON.stringify
+// for what is kept: functions and undefined are dropped from objects and
+// become null in arrays, as do non-finite numbers. Returns false for
+// objects that aren't plain.
+bool SerializeV8Value(v8::Handle<v8::Value> value, int depth,
+                      const PlainObjectCheck& check,
+                      BinaryMessageWriter* writer) {
+  if (depth > kMaxSerializationDepth)
+    return false;
+  if (value->IsObject() && !IsPlainObject(value.As<v8::Object>(), check))
+    return false;
+
+  if (value->IsString()) {
+    v8::String::Utf8Value str(value);
+    writer->WriteString(*str, str.length());
+  } else if (value->IsInt32()) {
+    writer->WriteInteger(value->Int32Value());
+  } else if (value->IsNumber()) {
+    double number = value->NumberValue();
+    if (!std::isfinite(number))
+      writer->WriteNull();
+    else
+      writer->WriteDouble(number);
+  } else if (value->IsBoolean()) {
+    writer->WriteBoolean(value->BooleanValue());
+  } else if (value->IsArray()) {
+    v8::Handle<v8::Array> array = value.As<v8::Array>();
+    uint32_t length = array->Length();
+    writer->WriteArrayHeader(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Handle<v8::Value> item = array->Get(i);
+      if (item->IsUndefined() || item->IsFunction()) {
+        writer->WriteNull();
+      } else if (!SerializeV8Value(item, depth + 1, check, writer)) {
+        return false;
+      }
+    }
+  } else if (value->IsObject()) {
+    v8::Handle<v8::Object> object = value.As<v8::Object>();
+    v8::Handle<v8::Array> names = object->GetOwnPropertyNames();
+    std::vector<v8::Handle<v8::Value> > keys;
+    std::vector<v8::Handle<v8::Value> > values;
+    for (uint32_t i = 0; i < names->Length(); ++i) {
+      v8::Handle<v8::Value> key = names->Get(i);
+      v8::Handle<v8::Value> item = object->Get(key);
+      if (item->IsUndefined() || item->IsFunction())
+        continue;
+      keys.push_back(key);
+      values.push_back(item);
+    }
+    writer->WriteMapHeader(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      v8::String::Utf8Value key(keys[i]->ToString());
+      writer->WriteString(*key, key.length());
+      if (!SerializeV8Value(values[i], depth + 1, check, writer))
+        return false;
+    }
+  } else {
+    writer->WriteNull();
+  }
+  return true;
+}
+
+// Runs the page's JSON.stringify on |value|.
+bool StringifyV8Value(v8::Isolate* isolate, v8::Handle<v8::Value> value,
+                      std::string* json) {
+  v8::Handle<v8::Object> global = isolate->GetCurrentContext()->Global();
+  v8::Handle<v8::Value> json_object =
+      global->Get(v8::String::NewFromUtf8(isolate, "JSON"));
+  if (!json_object->IsObject())
+    return false;
+  v8::Handle<v8::Value> stringify = json_object.As<v8::Object>()->Get(
+      v8::String::NewFromUtf8(isolate, "stringify"));
+  if (!stringify->IsFunction())
+    return false;
+
+  v8::TryCatch try_catch;
+  v8::Handle<v8::Value> argv[] = { value };
+  v8::Handle<v8::Value> result =
+      stringify.As<v8::Function>()->Call(json_object, 1, argv);
+  if (try_catch.HasCaught() || result.IsEmpty() || !result->IsString())
+    return false;
+  v8::String::Utf8Value str(result);
+  json->assign(*str, str.length());
+  return true;
+}
+
+enum MessageFormat {
+  kStringMessage,
+  kBinaryMessage,
+  kInvalidMessage,
+};
+
+// Messages given as plain objects or arrays skip JSON.stringify and go to
+// native as a binary message in |writer|. If a plain message holds a value
+// with its own JSON rules, JSON.stringify turns it into |str|. Anything
+// else goes as its string value, as it always has.
+MessageFormat SerializeMessage(v8::Isolate* isolate,
+                               v8::Handle<v8::Value> message,
+                               BinaryMessageWriter* writer, std::string* str) {
+  if (message->IsObject()) {
+    PlainObjectCheck check;
+    check.object_prototype = v8::Object::New(isolate)->GetPrototype();
+    check.to_json = v8::String::NewFromUtf8(isolate, "toJSON");
+    if (IsPlainObject(message.As<v8::Object>(), check)) {
+      if (SerializeV8Value(message, 0, check, writer))
+        return kBinaryMessage;
+      return StringifyV8Value(isolate, message, str) ? kStringMessage :
+                                                       kInvalidMessage;
+    }
+  }
+  v8::String::Utf8Value value(message->ToString());
+  str->assign(*value, value.length());
+  return kStringMessage;
+}
+
+v8::Handle<v8::Value> RunString(std::string* code, std::string* exception) {
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::EscapableHandleScope handle_scope(isolate);
-  v8::Handle<v8::String> v8_code(
-      v8::String::NewFromUtf8(isolate, code.c_str()));
+  v8::Handle<v8::String> v8_code(NewV8String(isolate, code, 0));
 
   v8::TryCatch try_catch;
   try_catch.SetVerbose(true);
@@ -276,7 +491,7 @@ void XWalkExtensionModule::LoadExtensionCode(
     extension_code_ = client_->GetExtensionJavascriptAPICode(extension_name_);
   }
   std::string wrapped_api_code = WrapAPICode(extension_code_, extension_name_);
-  v8::Handle<v8::Value> result = RunString(wrapped_api_code, &exception);
+  v8::Handle<v8::Value> result = RunString(&wrapped_api_code, &exception);
 
   if (!result->IsFunction()) {
     LOGGER(ERROR) << "Couldn't load JS API code for "
@@ -304,17 +519,25 @@ void XWalkExtensionModule::LoadExtensionCode(
   }
 }
 
-void XWalkExtensionModule::HandleMessageFromNative(const std::string& msg) {
+void XWalkExtensionModule::HandleMessageFromNative(std::string* msg) {
   if (message_listener_.IsEmpty())
     return;
 
+  if (batch_messages_) {
+    pending_messages_.push_back(std::string());
+    pending_messages_.back().swap(*msg);
+    if (!flush_source_id_)
+      flush_source_id_ = g_idle_add(FlushPendingMessagesCallback, this);
+    return;
+  }
+
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
   v8::Handle<v8::Context> context = module_system_->GetV8Context();
   v8::Context::Scope context_scope(context);
 
   v8::Handle<v8::Value> args[] = {
-      v8::String::NewFromUtf8(isolate, msg.c_str()) };
+      NewV8String(isolate, msg, kMinExternalMessageLength) };
 
   v8::Handle<v8::Function> message_listener =
       v8::Local<v8::Function>::New(isolate, message_listener_);
@@ -326,6 +549,85 @@ void XWalkExtensionModule::HandleMessageFromNative(const std::string& msg) {
                   << ExceptionToString(try_catch);
 }
 
+// static
+gboolean XWalkExtensionModule::FlushPendingMessagesCallback(
+    gpointer user_data) {
+  XWalkExtensionModule* self = static_cast<XWalkExtensionModule*>(user_data);
+  self->flush_source_id_ = 0;
+  self->FlushPendingMessages();
+  return FALSE;
+}
+
+void XWalkExtensionModule::FlushPendingMessages() {
+  std::vector<std::string> messages;
+  messages.swap(pending_messages_);
+  if (messages.empty() || message_listener_.IsEmpty())
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Context> context = module_system_->GetV8Context();
+  v8::Context::Scope context_scope(context);
+
+  v8::Handle<v8::Array> batch = v8::Array::New(isolate, messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    batch->Set(i,
+               NewV8String(isolate, &messages[i], kMinExternalMessageLength));
+  }
+  v8::Handle<v8::Value> args[] = { batch };
+
+  v8::Handle<v8::Function> message_listener =
+      v8::Local<v8::Function>::New(isolate, message_listener_);
+
+  v8::TryCatch try_catch;
+  message_listener->Call(context->Global(), 1, args);
+  if (try_catch.HasCaught())
+    LOGGER(ERROR) << "Exception when running message listener: "
+                  << ExceptionToString(try_catch);
+}
+
+void XWalkExtensionModule::HandleAsyncReplyFromNative(
+    int32_t request_id, std::string* reply, bool ok) {
+  auto it = pending_replies_.find(request_id);
+  if (it == pending_replies_.end()) {
+    LOGGER(WARN) << "Ignoring reply of unknown request " << request_id
+                 << " for " << extension_name_;
+    return;
+  }
+  v8::Persistent<v8::Promise::Resolver>* persistent = it->second;
+  pending_replies_.erase(it);
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Context> context = module_system_->GetV8Context();
+  v8::Context::Scope context_scope(context);
+
+  v8::Handle<v8::Promise::Resolver> resolver =
+      v8::Local<v8::Promise::Resolver>::New(isolate, *persistent);
+  persistent->Reset();
+  delete persistent;
+
+  if (ok) {
+    resolver->Resolve(NewV8String(isolate, reply, kMinExternalMessageLength));
+  } else {
+    resolver->Reject(v8::Exception::Error(v8::String::NewFromUtf8(
+        isolate, "Extension didn't reply to the message.")));
+  }
+
+  // The reply arrives from the main loop rather than from a script, so
+  // nothing else would run the reactions queued by resolving the promise.
+  isolate->RunMicrotasks();
+}
+
+void XWalkExtensionModule::HandlePropertyFromNative(const std::string& name,
+                                                    const std::string& value,
+                                                    bool valid) {
+  if (valid)
+    properties_[name] = value;
+  else
+    properties_.erase(name);
+}
+
 // static
 void XWalkExtensionModule::PostMessageCallback(
     const v8::FunctionCallbackInfo<v8::Value>& info) {
@@ -336,11 +638,23 @@ void XWalkExtensionModule::PostMessageCallback(
     return;
   }
 
-  v8::String::Utf8Value value(info[0]->ToString());
-
-  // CHECK(module->instance_id_);
-  module->client_->PostMessageToNative(module->instance_id_,
-                                       std::string(*value));
+  BinaryMessageWriter writer;
+  std::string message;
+  switch (SerializeMessage(info.GetIsolate(), info[0], &writer, &message)) {
+    case kBinaryMessage:
+      module->client_->PostBinaryMessageToNative(module->instance_id_,
+                                                 writer.data());
+      break;
+    case kStringMessage:
+      // CHECK(module->instance_id_);
+      module->client_->PostMessageToNative(module->instance_id_, message);
+      break;
+    case kInvalidMessage:
+      LOGGER(ERROR) << "Failed to serialize message for "
+                    << module->extension_name_;
+      result.Set(false);
+      return;
+  }
   result.Set(true);
 }
 
@@ -354,26 +668,87 @@ void XWalkExtensionModule::SendSyncMessageCallback(
     return;
   }
 
-  v8::String::Utf8Value value(info[0]->ToString());
-
-  // CHECK(module->instance_id_);
-  std::string reply =
-      module->client_->SendSyncMessageToNative(module->instance_id_,
-                                               std::string(*value));
+  BinaryMessageWriter writer;
+  std::string message;
+  std::string reply;
+  switch (SerializeMessage(info.GetIsolate(), info[0], &writer, &message)) {
+    case kBinaryMessage:
+      reply = module->client_->SendSyncBinaryMessageToNative(
+          module->instance_id_, writer.data());
+      break;
+    case kStringMessage:
+      // CHECK(module->instance_id_);
+      reply = module->client_->SendSyncMessageToNative(module->instance_id_,
+                                                       message);
+      break;
+    case kInvalidMessage:
+      LOGGER(ERROR) << "Failed to serialize message for "
+                    << module->extension_name_;
+      result.Set(false);
+      return;
+  }
 
   // If we tried to send a message to an instance that became invalid,
   // then reply will be NULL.
   if (!reply.empty()) {
-    result.Set(v8::String::NewFromUtf8(info.GetIsolate(), reply.c_str()));
+    result.Set(NewV8String(info.GetIsolate(), &reply,
+                           kMinExternalMessageLength));
   }
 }
 
 // static
-void XWalkExtensionModule::SetMessageListenerCallback(
+void XWalkExtensionModule::SendMessageAsyncCallback(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::Isolate* isolate = info.GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  v8::ReturnValue<v8::Value> result(info.GetReturnValue());
+  v8::Handle<v8::Promise::Resolver> resolver =
+      v8::Promise::Resolver::New(isolate);
+  result.Set(resolver->GetPromise());
+
+  XWalkExtensionModule* module = GetExtensionModule(info);
+  if (!module || info.Length() != 1 || module->instance_id_.empty()) {
+    resolver->Reject(v8::Exception::Error(v8::String::NewFromUtf8(
+        isolate, "Extension is not available to handle the message.")));
+    return;
+  }
+
+  v8::String::Utf8Value value(info[0]->ToString());
+
+  int32_t request_id = module->next_request_id_++;
+  module->pending_replies_[request_id] =
+      new v8::Persistent<v8::Promise::Resolver>(isolate, resolver);
+  module->client_->SendAsyncMessageToNative(module->instance_id_, request_id,
+                                            std::string(*value));
+}
+
+// static
+void XWalkExtensionModule::GetPropertyCallback(
     const v8::FunctionCallbackInfo<v8::Value>& info) {
   v8::ReturnValue<v8::Value> result(info.GetReturnValue());
   XWalkExtensionModule* module = GetExtensionModule(info);
   if (!module || info.Length() != 1) {
+    result.SetUndefined();
+    return;
+  }
+
+  v8::String::Utf8Value name(info[0]->ToString());
+  auto it = module->properties_.find(std::string(*name));
+  if (it == module->properties_.end()) {
+    result.SetUndefined();
+    return;
+  }
+
+  result.Set(v8::String::NewFromUtf8(info.GetIsolate(), it->second.c_str()));
+}
+
+// static
+void XWalkExtensionModule::SetMessageListenerCallback(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::ReturnValue<v8::Value> result(info.GetReturnValue());
+  XWalkExtensionModule* module = GetExtensionModule(info);
+  if (!module || info.Length() < 1 || info.Length() > 2) {
     result.Set(false);
     return;
   }
@@ -384,11 +759,19 @@ void XWalkExtensionModule::SetMessageListenerCallback(
     return;
   }
 
+  // Hand messages already queued to the listener that asked for batching.
+  if (module->flush_source_id_) {
+    g_source_remove(module->flush_source_id_);
+    module->flush_source_id_ = 0;
+    module->FlushPendingMessages();
+  }
+
   v8::Isolate* isolate = info.GetIsolate();
   if (info[0]->IsUndefined())
     module->message_listener_.Reset();
   else
     module->message_listener_.Reset(isolate, info[0].As<v8::Function>());
+  module->batch_messages_ = info.Length() > 1 && info[1]->BooleanValue();
 
   result.Set(true);
 }
@@ -501,7 +884,8 @@ XWalkExtensionModule* XWalkExtensionModule::GetExtensionModule(
 
   v8::Local<v8::Object> data = info.Data().As<v8::Object>();
   v8::Local<v8::Value> module =
-      data->Get(v8::String::NewFromUtf8(isolate, kXWalkExtensionModule));
+      data->Get(XWalkStringCache::GetInstance(isolate)->Get(
+          kXWalkExtensionModule));
   if (module.IsEmpty() || module->IsUndefined()) {
     LOGGER(ERROR) << "Trying to use extension from already destroyed context!";
     return NULL;
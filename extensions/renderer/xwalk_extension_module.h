@@ -7,10 +7,13 @@
 #ifndef XWALK_EXTENSIONS_RENDERER_XWALK_EXTENSION_MODULE_H_
 #define XWALK_EXTENSIONS_RENDERER_XWALK_EXTENSION_MODULE_H_
 
+#include <glib.h>
 #include <v8/v8.h>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "extensions/renderer/xwalk_extension_client.h"
 
@@ -41,13 +44,23 @@ class XWalkExtensionModule : public XWalkExtensionClient::InstanceHandler {
 
  private:
   // ExtensionClient::InstanceHandler implementation.
-  virtual void HandleMessageFromNative(const std::string& msg);
+  virtual void HandleMessageFromNative(std::string* msg);
+  virtual void HandleAsyncReplyFromNative(int32_t request_id,
+                                          std::string* reply,
+                                          bool ok);
+  virtual void HandlePropertyFromNative(const std::string& name,
+                                        const std::string& value,
+                                        bool valid);
 
   // Callbacks for JS functions available in 'extension' object.
   static void PostMessageCallback(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SendSyncMessageCallback(
       const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void SendMessageAsyncCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetPropertyCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetMessageListenerCallback(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SendRuntimeMessageCallback(
@@ -60,6 +73,10 @@ class XWalkExtensionModule : public XWalkExtensionClient::InstanceHandler {
   static XWalkExtensionModule* GetExtensionModule(
       const v8::FunctionCallbackInfo<v8::Value>& info);
 
+  // Delivers the messages queued for a batched message listener.
+  static gboolean FlushPendingMessagesCallback(gpointer user_data);
+  void FlushPendingMessages();
+
   // Template for the 'extension' object exposed to the extension JS code.
   v8::Persistent<v8::ObjectTemplate> object_template_;
 
@@ -71,12 +88,30 @@ class XWalkExtensionModule : public XWalkExtensionClient::InstanceHandler {
   // This value is registered by using 'extension.setMessageListener()'.
   v8::Persistent<v8::Function> message_listener_;
 
+  // When set by 'extension.setMessageListener(listener, true)', messages
+  // arriving back to back are queued and handed to the listener as one array
+  // from an idle callback, instead of entering the context once per message.
+  bool batch_messages_;
+  std::vector<std::string> pending_messages_;
+  guint flush_source_id_;
+
   std::string extension_name_;
   std::string extension_code_;
 
   XWalkExtensionClient* client_;
   XWalkModuleSystem* module_system_;
   std::string instance_id_;
+
+  // Promises returned by 'extension.sendMessageAsync()' that are waiting for
+  // the reply of the extension, keyed by request id.
+  typedef std::map<int32_t, v8::Persistent<v8::Promise::Resolver>*>
+      PendingReplyMap;
+  PendingReplyMap pending_replies_;
+  int32_t next_request_id_;
+
+  // Values published by the extension through the property cache interface,
+  // read by 'extension.getProperty()' without asking the extension.
+  std::map<std::string, std::string> properties_;
 };
 
 }  // namespace extensions
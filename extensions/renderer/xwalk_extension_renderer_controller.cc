@@ -6,8 +6,10 @@
 #include "extensions/renderer/xwalk_extension_renderer_controller.h"
 
 #include <v8/v8.h>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/logger.h"
 #include "common/profiler.h"
@@ -41,6 +43,38 @@ void CreateExtensionModules(XWalkExtensionClient* client,
   }
 }
 
+void RegisterNativeModules(XWalkModuleSystem* module_system) {
+  module_system->RegisterNativeModule(
+        "v8tools",
+        std::unique_ptr<XWalkNativeModule>(new XWalkV8ToolsModule));
+  module_system->RegisterNativeModule(
+        "WidgetModule",
+        std::unique_ptr<XWalkNativeModule>(new WidgetModule));
+  module_system->RegisterNativeModule(
+        "objecttools",
+        std::unique_ptr<XWalkNativeModule>(new ObjectToolsModule));
+}
+
+std::string GetRootName(const std::string& name) {
+  return name.substr(0, name.find('.'));
+}
+
+void CollectRootNames(XWalkExtensionClient* client,
+                      std::vector<std::string>* root_names) {
+  std::set<std::string> names;
+  const XWalkExtensionClient::ExtensionAPIMap& extensions =
+      client->extension_apis();
+  auto it = extensions.begin();
+  for (; it != extensions.end(); ++it) {
+    names.insert(GetRootName(it->first));
+    auto entry_it = it->second->entry_points.begin();
+    for (; entry_it != it->second->entry_points.end(); ++entry_it) {
+      names.insert(GetRootName(*entry_it));
+    }
+  }
+  root_names->assign(names.begin(), names.end());
+}
+
 }  // namespace
 
 XWalkExtensionRendererController&
@@ -63,18 +97,15 @@ void XWalkExtensionRendererController::DidCreateScriptContext(
   XWalkModuleSystem::SetModuleSystemInContext(
       std::unique_ptr<XWalkModuleSystem>(module_system), context);
 
-  module_system->RegisterNativeModule(
-        "v8tools",
-        std::unique_ptr<XWalkNativeModule>(new XWalkV8ToolsModule));
-  module_system->RegisterNativeModule(
-        "WidgetModule",
-        std::unique_ptr<XWalkNativeModule>(new WidgetModule));
-  module_system->RegisterNativeModule(
-        "objecttools",
-        std::unique_ptr<XWalkNativeModule>(new ObjectToolsModule));
-
-  CreateExtensionModules(extensions_client_.get(), module_system);
-  module_system->Initialize();
+  // The native modules and extension modules are created only when the
+  // frame touches one of the extension namespaces for the first time.
+  XWalkExtensionClient* client = extensions_client_.get();
+  module_system->InitializeLazily(
+      root_names_, [client](XWalkModuleSystem* system) {
+    RegisterNativeModules(system);
+    CreateExtensionModules(client, system);
+    system->Initialize();
+  });
 }
 
 void XWalkExtensionRendererController::WillReleaseScriptContext(
@@ -85,7 +116,10 @@ void XWalkExtensionRendererController::WillReleaseScriptContext(
 
 bool XWalkExtensionRendererController::InitializeExtensions(
     const std::string& appid) {
-  return extensions_client_->Initialize(appid);
+  if (!extensions_client_->Initialize(appid))
+    return false;
+  CollectRootNames(extensions_client_.get(), &root_names_);
+  return true;
 }
 
 }  // namespace extensions
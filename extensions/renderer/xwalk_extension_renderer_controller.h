@@ -9,6 +9,7 @@
 #include <v8/v8.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace extensions {
 
@@ -29,6 +30,10 @@ class XWalkExtensionRendererController {
 
  private:
   std::unique_ptr<XWalkExtensionClient> extensions_client_;
+
+  // Top-level names of all extensions and their entry points. Accessors for
+  // these are the only thing installed until a frame uses an extension.
+  std::vector<std::string> root_names_;
 };
 
 }  // namespace extensions
@@ -11,6 +11,7 @@
 
 #include "common/logger.h"
 #include "extensions/renderer/xwalk_extension_module.h"
+#include "extensions/renderer/xwalk_string_cache.h"
 
 namespace extensions {
 
@@ -32,8 +33,8 @@ void RequireNativeCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
   v8::HandleScope handle_scope(isolate);
 
   v8::Handle<v8::Object> data = info.Data().As<v8::Object>();
-  v8::Handle<v8::Value> module_system_value =
-      data->Get(v8::String::NewFromUtf8(isolate, kXWalkModuleSystem));
+  v8::Handle<v8::Value> module_system_value = data->Get(
+      XWalkStringCache::GetInstance(isolate)->Get(kXWalkModuleSystem));
   if (module_system_value.IsEmpty() || module_system_value->IsUndefined()) {
     LOGGER(ERROR) << "Trying to use requireNative from already "
                   << "destroyed module system!";
@@ -66,8 +67,9 @@ XWalkModuleSystem::XWalkModuleSystem(v8::Handle<v8::Context> context) {
 
   v8::HandleScope handle_scope(isolate);
   v8::Handle<v8::Object> function_data = v8::Object::New(isolate);
-  function_data->Set(v8::String::NewFromUtf8(isolate, kXWalkModuleSystem),
-                     v8::External::New(isolate, this));
+  function_data->Set(
+      XWalkStringCache::GetInstance(isolate)->Get(kXWalkModuleSystem),
+      v8::External::New(isolate, this));
   v8::Handle<v8::FunctionTemplate> require_native_template =
       v8::FunctionTemplate::New(isolate, RequireNativeCallback, function_data);
 
@@ -154,16 +156,29 @@ void XWalkModuleSystem::RegisterNativeModule(
 
 namespace {
 
+typedef std::vector<v8::Eternal<v8::String> > KeyPath;
+
+// Takes the handle by value, as v8::Eternal::Get() is not const.
+v8::Local<v8::String> GetKey(v8::Isolate* isolate,
+                             v8::Eternal<v8::String> key) {
+  return key.Get(isolate);
+}
+
+std::string KeyToString(v8::Isolate* isolate,
+                        const v8::Eternal<v8::String>& key) {
+  return *v8::String::Utf8Value(GetKey(isolate, key));
+}
+
+// Walks the path up to the parent of the last component, creating the
+// objects that don't exist yet.
 v8::Handle<v8::Value> EnsureTargetObjectForTrampoline(
-    v8::Handle<v8::Context> context, const std::vector<std::string>& path,
+    v8::Handle<v8::Context> context, const KeyPath& path,
     std::string* error) {
   v8::Handle<v8::Object> object = context->Global();
   v8::Isolate* isolate = context->GetIsolate();
 
-  std::vector<std::string>::const_iterator it = path.begin();
-  for (; it != path.end(); ++it) {
-    v8::Handle<v8::String> part =
-        v8::String::NewFromUtf8(isolate, it->c_str());
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    v8::Handle<v8::String> part = GetKey(isolate, path[i]);
     v8::Handle<v8::Value> value = object->Get(part);
 
     if (value->IsUndefined()) {
@@ -174,7 +189,8 @@ v8::Handle<v8::Value> EnsureTargetObjectForTrampoline(
     }
 
     if (!value->IsObject()) {
-      *error = "the property '" + *it + "' in the path is undefined";
+      *error = "the property '" + KeyToString(isolate, path[i]) +
+               "' in the path is undefined";
       return v8::Undefined(isolate);
     }
 
@@ -183,20 +199,19 @@ v8::Handle<v8::Value> EnsureTargetObjectForTrampoline(
   return object;
 }
 
+// Returns the object holding the last component of the path.
 v8::Handle<v8::Value> GetObjectForPath(v8::Handle<v8::Context> context,
-                                       const std::vector<std::string>& path,
+                                       const KeyPath& path,
                                        std::string* error) {
   v8::Handle<v8::Object> object = context->Global();
   v8::Isolate* isolate = context->GetIsolate();
 
-  std::vector<std::string>::const_iterator it = path.begin();
-  for (; it != path.end(); ++it) {
-    v8::Handle<v8::String> part =
-        v8::String::NewFromUtf8(isolate, it->c_str());
-    v8::Handle<v8::Value> value = object->Get(part);
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    v8::Handle<v8::Value> value = object->Get(GetKey(isolate, path[i]));
 
     if (!value->IsObject()) {
-      *error = "the property '" + *it + "' in the path is undefined";
+      *error = "the property '" + KeyToString(isolate, path[i]) +
+               "' in the path is undefined";
       return v8::Undefined(isolate);
     }
 
@@ -225,32 +240,27 @@ void SplitString(const STR& str, const typename STR::value_type s,
 
 bool XWalkModuleSystem::SetTrampolineAccessorForEntryPoint(
     v8::Handle<v8::Context> context,
-    const std::string& entry_point,
+    const EntryPointPath& entry_point,
     v8::Local<v8::External> user_data) {
-  std::vector<std::string> path;
-  SplitString(entry_point, '.', &path);
-  std::string basename = path.back();
-  path.pop_back();
-
   std::string error;
   v8::Handle<v8::Value> value =
-      EnsureTargetObjectForTrampoline(context, path, &error);
+      EnsureTargetObjectForTrampoline(context, entry_point.keys, &error);
   if (value->IsUndefined()) {
-    LOGGER(ERROR) << "Error installing trampoline for " << entry_point
+    LOGGER(ERROR) << "Error installing trampoline for " << entry_point.name
                   << " : " << error;
     return false;
   }
 
   v8::Isolate* isolate = context->GetIsolate();
   v8::Local<v8::Array> params = v8::Array::New(isolate);
-  v8::Local<v8::String> entry =
-      v8::String::NewFromUtf8(isolate, entry_point.c_str());
-  params->Set(v8::Integer::New(isolate, 0), user_data);
-  params->Set(v8::Integer::New(isolate, 1), entry);
+  v8::Local<v8::External> entry = v8::External::New(
+      isolate, const_cast<EntryPointPath*>(&entry_point));
+  params->Set(0, user_data);
+  params->Set(1, entry);
 
   // FIXME(cmarcelo): ensure that trampoline is readonly.
   value.As<v8::Object>()->SetAccessor(
-      v8::String::NewFromUtf8(isolate, basename.c_str()),
+      GetKey(isolate, entry_point.keys.back()),
       TrampolineCallback, TrampolineSetterCallback, params);
   return true;
 }
@@ -258,22 +268,18 @@ bool XWalkModuleSystem::SetTrampolineAccessorForEntryPoint(
 // static
 bool XWalkModuleSystem::DeleteAccessorForEntryPoint(
     v8::Handle<v8::Context> context,
-    const std::string& entry_point) {
-  std::vector<std::string> path;
-  SplitString(entry_point, '.', &path);
-  std::string basename = path.back();
-  path.pop_back();
-
+    const EntryPointPath& entry_point) {
   std::string error;
-  v8::Handle<v8::Value> value = GetObjectForPath(context, path, &error);
+  v8::Handle<v8::Value> value =
+      GetObjectForPath(context, entry_point.keys, &error);
   if (value->IsUndefined()) {
-    LOGGER(ERROR) << "Error retrieving object for " << entry_point
+    LOGGER(ERROR) << "Error retrieving object for " << entry_point.name
                   << " : " << error;
     return false;
   }
 
   value.As<v8::Object>()->Delete(
-      v8::String::NewFromUtf8(context->GetIsolate(), basename.c_str()));
+      GetKey(context->GetIsolate(), entry_point.keys.back()));
   return true;
 }
 
@@ -281,16 +287,10 @@ bool XWalkModuleSystem::InstallTrampoline(v8::Handle<v8::Context> context,
                                      ExtensionModuleEntry* entry) {
   v8::Local<v8::External> entry_ptr =
       v8::External::New(context->GetIsolate(), entry);
-  bool ret = SetTrampolineAccessorForEntryPoint(context, entry->name,
-                                                entry_ptr);
-  if (!ret) {
-    LOGGER(ERROR) << "Error installing trampoline for " << entry->name;
-    return false;
-  }
 
-  auto it = entry->entry_points.begin();
-  for (; it != entry->entry_points.end(); ++it) {
-    ret = SetTrampolineAccessorForEntryPoint(context, *it, entry_ptr);
+  auto it = entry->paths.begin();
+  for (; it != entry->paths.end(); ++it) {
+    bool ret = SetTrampolineAccessorForEntryPoint(context, *it, entry_ptr);
     if (!ret) {
       // TODO(vcgomes): Remove already added trampolines when it fails.
       LOGGER(ERROR) << "Error installing trampoline for " << entry->name;
@@ -326,10 +326,64 @@ void XWalkModuleSystem::Initialize() {
     if (it->use_trampoline && InstallTrampoline(context, &*it))
       continue;
     it->module->LoadExtensionCode(context, require_native);
-    EnsureExtensionNamespaceIsReadOnly(context, it->name);
+    EnsureExtensionNamespaceIsReadOnly(context, it->paths.front());
   }
 }
 
+void XWalkModuleSystem::InitializeLazily(
+    const std::vector<std::string>& root_names,
+    LazyInitializer initializer) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Context> context = GetV8Context();
+  v8::Handle<v8::Object> global = context->Global();
+
+  XWalkStringCache* strings = XWalkStringCache::GetInstance(isolate);
+  std::vector<v8::Eternal<v8::String> > names;
+  auto it = root_names.begin();
+  for (; it != root_names.end(); ++it) {
+    v8::Eternal<v8::String> name = strings->Intern(*it);
+    // An entry point under an existing global, e.g. navigator.*, can't be
+    // hooked without hiding the builtin, so everything is set up now.
+    if (global->Has(name.Get(isolate))) {
+      LOGGER(DEBUG) << "'" << *it << "' is already defined, "
+                    << "the extensions are initialized eagerly";
+      initializer(this);
+      return;
+    }
+    names.push_back(name);
+  }
+
+  lazy_initializer_ = initializer;
+  for (auto& name : names) {
+    global->SetAccessor(name.Get(isolate),
+                        BootstrapCallback, BootstrapSetterCallback);
+    lazy_root_names_.push_back(name);
+  }
+}
+
+void XWalkModuleSystem::EnsureInitialized() {
+  if (!lazy_initializer_)
+    return;
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Handle<v8::Object> global = GetV8Context()->Global();
+
+  // The bootstrap accessors should be removed before the initializer runs,
+  // otherwise installing the trampolines would call them again. Only names
+  // that weren't defined before InitializeLazily() have one.
+  auto it = lazy_root_names_.begin();
+  for (; it != lazy_root_names_.end(); ++it) {
+    global->Delete(it->Get(isolate));
+  }
+  lazy_root_names_.clear();
+
+  LazyInitializer initializer = lazy_initializer_;
+  lazy_initializer_ = nullptr;
+  initializer(this);
+}
+
 v8::Handle<v8::Context> XWalkModuleSystem::GetV8Context() {
   return v8::Local<v8::Context>::New(v8::Isolate::GetCurrent(), v8_context_);
 }
@@ -363,8 +417,7 @@ void XWalkModuleSystem::LoadExtensionForTrampoline(
     v8::Isolate* isolate,
     v8::Local<v8::Value> data) {
   v8::Local<v8::Array> params = data.As<v8::Array>();
-  void* ptr = params->Get(
-      v8::Integer::New(isolate, 0)).As<v8::External>()->Value();
+  void* ptr = params->Get(0).As<v8::External>()->Value();
 
   ExtensionModuleEntry* entry = static_cast<ExtensionModuleEntry*>(ptr);
 
@@ -373,10 +426,8 @@ void XWalkModuleSystem::LoadExtensionForTrampoline(
 
   v8::Handle<v8::Context> context = isolate->GetCurrentContext();
 
-  DeleteAccessorForEntryPoint(context, entry->name);
-
-  auto it = entry->entry_points.begin();
-  for (; it != entry->entry_points.end(); ++it) {
+  auto it = entry->paths.begin();
+  for (; it != entry->paths.end(); ++it) {
     DeleteAccessorForEntryPoint(context, *it);
   }
 
@@ -391,7 +442,8 @@ void XWalkModuleSystem::LoadExtensionForTrampoline(
   module->LoadExtensionCode(module_system->GetV8Context(),
                             require_native_template->GetFunction());
 
-  module_system->EnsureExtensionNamespaceIsReadOnly(context, entry->name);
+  module_system->EnsureExtensionNamespaceIsReadOnly(context,
+                                                    entry->paths.front());
 }
 
 // static
@@ -399,15 +451,12 @@ v8::Handle<v8::Value> XWalkModuleSystem::RefetchHolder(
     v8::Isolate* isolate,
     v8::Local<v8::Value> data) {
   v8::Local<v8::Array> params = data.As<v8::Array>();
-  const std::string entry_point = *v8::String::Utf8Value(
-      params->Get(v8::Integer::New(isolate, 1)).As<v8::String>());
-
-  std::vector<std::string> path;
-  SplitString(entry_point, '.', &path);
-  path.pop_back();
+  const EntryPointPath* entry_point = static_cast<EntryPointPath*>(
+      params->Get(1).As<v8::External>()->Value());
 
   std::string error;
-  return GetObjectForPath(isolate->GetCurrentContext(), path, &error);
+  return GetObjectForPath(isolate->GetCurrentContext(), entry_point->keys,
+                          &error);
 }
 
 // static
@@ -435,17 +484,66 @@ void XWalkModuleSystem::TrampolineSetterCallback(
   holder.As<v8::Object>()->Set(property, value);
 }
 
+// static
+void XWalkModuleSystem::BootstrapCallback(
+    v8::Local<v8::String> property,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  // The accessor may be reached from another frame, e.g. "parent.tizen",
+  // the module system is the one of the global object that has it.
+  v8::Handle<v8::Context> context = info.Holder()->CreationContext();
+  XWalkModuleSystem* module_system = GetModuleSystemFromContext(context);
+  if (!module_system)
+    return;
+  v8::Context::Scope context_scope(context);
+  module_system->EnsureInitialized();
+
+  info.GetReturnValue().Set(context->Global()->Get(property));
+}
+
+// static
+void XWalkModuleSystem::BootstrapSetterCallback(
+    v8::Local<v8::String> property,
+    v8::Local<v8::Value> value,
+    const v8::PropertyCallbackInfo<void>& info) {
+  v8::Handle<v8::Context> context = info.Holder()->CreationContext();
+  XWalkModuleSystem* module_system = GetModuleSystemFromContext(context);
+  if (!module_system)
+    return;
+  v8::Context::Scope context_scope(context);
+  module_system->EnsureInitialized();
+
+  context->Global()->Set(property, value);
+}
+
 XWalkModuleSystem::ExtensionModuleEntry::ExtensionModuleEntry(
     const std::string& name,
     XWalkExtensionModule* module,
     const std::vector<std::string>& entry_points) :
     name(name), module(module), use_trampoline(true),
     entry_points(entry_points) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  paths.push_back(EntryPointPath(isolate, name));
+  auto it = entry_points.begin();
+  for (; it != entry_points.end(); ++it) {
+    paths.push_back(EntryPointPath(isolate, *it));
+  }
 }
 
 XWalkModuleSystem::ExtensionModuleEntry::~ExtensionModuleEntry() {
 }
 
+XWalkModuleSystem::EntryPointPath::EntryPointPath(v8::Isolate* isolate,
+                                                  const std::string& name)
+    : name(name) {
+  XWalkStringCache* strings = XWalkStringCache::GetInstance(isolate);
+  std::vector<std::string> parts;
+  SplitString(name, '.', &parts);
+  auto it = parts.begin();
+  for (; it != parts.end(); ++it) {
+    keys.push_back(strings->Intern(*it));
+  }
+}
+
 // Returns whether the name of first is prefix of the second, considering "."
 // character as a separator. So "a" is prefix of "a.b" but not of "ab".
 bool XWalkModuleSystem::ExtensionModuleEntry::IsPrefix(
@@ -481,22 +579,18 @@ void XWalkModuleSystem::MarkModulesWithTrampoline() {
 
 void XWalkModuleSystem::EnsureExtensionNamespaceIsReadOnly(
     v8::Handle<v8::Context> context,
-    const std::string& extension_name) {
-  std::vector<std::string> path;
-  SplitString(extension_name, '.', &path);
-  std::string basename = path.back();
-  path.pop_back();
-
+    const EntryPointPath& extension_name) {
   std::string error;
-  v8::Handle<v8::Value> value = GetObjectForPath(context, path, &error);
+  v8::Handle<v8::Value> value =
+      GetObjectForPath(context, extension_name.keys, &error);
   if (value->IsUndefined()) {
-    LOGGER(ERROR) << "Error retrieving object for " << extension_name << " : "
-                  << error;
+    LOGGER(ERROR) << "Error retrieving object for " << extension_name.name
+                  << " : " << error;
     return;
   }
 
   v8::Handle<v8::String> v8_extension_name(
-      v8::String::NewFromUtf8(context->GetIsolate(), basename.c_str()));
+      GetKey(context->GetIsolate(), extension_name.keys.back()));
   value.As<v8::Object>()->ForceSet(
       v8_extension_name, value.As<v8::Object>()->Get(v8_extension_name),
       v8::ReadOnly);
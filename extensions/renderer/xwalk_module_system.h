@@ -8,6 +8,7 @@
 
 #include <v8/v8.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -28,6 +29,8 @@ class XWalkNativeModule {
 
 class XWalkModuleSystem {
  public:
+  typedef std::function<void(XWalkModuleSystem*)> LazyInitializer;
+
   explicit XWalkModuleSystem(v8::Handle<v8::Context> context);
   ~XWalkModuleSystem();
 
@@ -46,9 +49,27 @@ class XWalkModuleSystem {
 
   void Initialize();
 
+  // Installs only accessors for the given top-level names on the global
+  // object. The |initializer| is expected to register the modules and call
+  // Initialize(), and runs the first time one of these names is touched.
+  // If one of the names is already defined on the global object, the
+  // |initializer| runs right away instead.
+  void InitializeLazily(const std::vector<std::string>& root_names,
+                        LazyInitializer initializer);
+  void EnsureInitialized();
+
   v8::Handle<v8::Context> GetV8Context();
 
  private:
+  // An entry point split into its path components. The components are kept
+  // as interned strings, so the trampolines can walk the path without
+  // allocating new strings.
+  struct EntryPointPath {
+    EntryPointPath(v8::Isolate* isolate, const std::string& name);
+    std::string name;
+    std::vector<v8::Eternal<v8::String> > keys;
+  };
+
   struct ExtensionModuleEntry {
     ExtensionModuleEntry(const std::string& name, XWalkExtensionModule* module,
                          const std::vector<std::string>& entry_points);
@@ -57,6 +78,8 @@ class XWalkModuleSystem {
     XWalkExtensionModule* module;
     bool use_trampoline;
     std::vector<std::string> entry_points;
+    // Paths for the extension name followed by the ones of entry_points.
+    std::vector<EntryPointPath> paths;
     bool operator<(const ExtensionModuleEntry& other) const {
       return name < other.name;
     }
@@ -67,11 +90,11 @@ class XWalkModuleSystem {
 
   bool SetTrampolineAccessorForEntryPoint(
       v8::Handle<v8::Context> context,
-      const std::string& entry_point,
+      const EntryPointPath& entry_point,
       v8::Local<v8::External> user_data);
 
   static bool DeleteAccessorForEntryPoint(v8::Handle<v8::Context> context,
-                                          const std::string& entry_point);
+                                          const EntryPointPath& entry_point);
 
   bool InstallTrampoline(v8::Handle<v8::Context> context,
                          ExtensionModuleEntry* entry);
@@ -90,18 +113,29 @@ class XWalkModuleSystem {
     v8::Isolate* isolate,
     v8::Local<v8::Value> data);
 
+  static void BootstrapCallback(
+      v8::Local<v8::String> property,
+      const v8::PropertyCallbackInfo<v8::Value>& info);
+  static void BootstrapSetterCallback(
+      v8::Local<v8::String> property,
+      v8::Local<v8::Value> value,
+      const v8::PropertyCallbackInfo<void>& info);
+
   bool ContainsEntryPoint(const std::string& entry_point);
   void MarkModulesWithTrampoline();
   void DeleteExtensionModules();
 
   void EnsureExtensionNamespaceIsReadOnly(v8::Handle<v8::Context> context,
-                                          const std::string& extension_name);
+                                          const EntryPointPath& extension_name);
 
   typedef std::vector<ExtensionModuleEntry> ExtensionModules;
   ExtensionModules extension_modules_;
   typedef std::map<std::string, XWalkNativeModule*> NativeModuleMap;
   NativeModuleMap native_modules_;
 
+  std::vector<v8::Eternal<v8::String> > lazy_root_names_;
+  LazyInitializer lazy_initializer_;
+
   v8::Persistent<v8::FunctionTemplate> require_native_template_;
   v8::Persistent<v8::Object> function_data_;
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "extensions/renderer/xwalk_string_cache.h"
+
+#include <v8/v8.h>
+
+#include <map>
+#include <string>
+
+namespace extensions {
+
+// static
+XWalkStringCache* XWalkStringCache::GetInstance(v8::Isolate* isolate) {
+  static std::map<v8::Isolate*, XWalkStringCache*> instances;
+  auto it = instances.find(isolate);
+  if (it != instances.end())
+    return it->second;
+  XWalkStringCache* cache = new XWalkStringCache(isolate);
+  instances[isolate] = cache;
+  return cache;
+}
+
+XWalkStringCache::XWalkStringCache(v8::Isolate* isolate)
+    : isolate_(isolate) {
+}
+
+XWalkStringCache::~XWalkStringCache() {
+}
+
+v8::Local<v8::String> XWalkStringCache::Get(const char* key) {
+  auto it = constants_.find(key);
+  if (it != constants_.end())
+    return it->second.Get(isolate_);
+
+  v8::Local<v8::String> str = v8::String::NewFromUtf8(
+      isolate_, key, v8::String::kInternalizedString);
+  constants_[key].Set(isolate_, str);
+  return str;
+}
+
+v8::Eternal<v8::String> XWalkStringCache::Intern(const std::string& str) {
+  auto it = strings_.find(str);
+  if (it != strings_.end())
+    return it->second;
+
+  v8::HandleScope handle_scope(isolate_);
+  v8::Eternal<v8::String>& eternal = strings_[str];
+  eternal.Set(isolate_, v8::String::NewFromUtf8(
+      isolate_, str.c_str(), v8::String::kInternalizedString, str.length()));
+  return eternal;
+}
+
+}  // namespace extensions
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef XWALK_EXTENSIONS_RENDERER_XWALK_STRING_CACHE_H_
+#define XWALK_EXTENSIONS_RENDERER_XWALK_STRING_CACHE_H_
+
+#include <v8/v8.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace extensions {
+
+// Keeps internalized, eternal v8 strings for the property keys used on the
+// hot paths of the module system, so that accessors and callbacks don't
+// allocate a new v8::String for the same key on every invocation.
+class XWalkStringCache {
+ public:
+  static XWalkStringCache* GetInstance(v8::Isolate* isolate);
+
+  // Returns the string for a constant key. The |key| should have static
+  // storage duration, because its address is used for the lookup.
+  v8::Local<v8::String> Get(const char* key);
+
+  // Returns the eternal handle for a string known only at runtime, such as
+  // a component of an extension entry point.
+  v8::Eternal<v8::String> Intern(const std::string& str);
+
+ private:
+  explicit XWalkStringCache(v8::Isolate* isolate);
+  ~XWalkStringCache();
+
+  v8::Isolate* isolate_;
+  std::unordered_map<const char*, v8::Eternal<v8::String> > constants_;
+  std::map<std::string, v8::Eternal<v8::String> > strings_;
+};
+
+}  // namespace extensions
+
+#endif  // XWALK_EXTENSIONS_RENDERER_XWALK_STRING_CACHE_H_
@@ -27,6 +27,7 @@ BuildRequires: edje-tools
 BuildRequires: gettext
 BuildRequires: ninja
 BuildRequires: python
+BuildRequires: shared-mime-info
 BuildRequires: pkgconfig(appsvc)
 BuildRequires: pkgconfig(aul)
 BuildRequires: pkgconfig(bundle)
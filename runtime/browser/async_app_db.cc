@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+#include "runtime/browser/async_app_db.h"
+
+#include <Ecore.h>
+
+#include "common/app_db.h"
+
+namespace runtime {
+
+namespace {
+
+struct MainLoopCall {
+  std::weak_ptr<bool> alive;
+  std::function<void()> callback;
+};
+
+void RunOnMainLoop(std::weak_ptr<bool> alive,
+                   std::function<void()> callback) {
+  MainLoopCall* call = new MainLoopCall;
+  call->alive = alive;
+  call->callback = callback;
+  ecore_main_loop_thread_safe_call_async([](void* data) {
+    std::unique_ptr<MainLoopCall> call(static_cast<MainLoopCall*>(data));
+    if (call->alive.lock())
+      call->callback();
+  }, call);
+}
+
+}  // namespace
+
+AsyncAppDB::AsyncAppDB()
+    : queue_(g_async_queue_new()),
+      thread_(NULL),
+      alive_(new bool(true)) {
+  thread_ = g_thread_new("AppDB", ThreadMain, this);
+}
+
+AsyncAppDB::~AsyncAppDB() {
+  alive_.reset();
+  // An empty task makes the thread quit after the ones posted before it,
+  // so that no write is lost.
+  g_async_queue_push(queue_, new Task());
+  g_thread_join(thread_);
+  g_async_queue_unref(queue_);
+}
+
+void AsyncAppDB::Get(const std::string& section,
+                     const std::string& key,
+                     GetCallback callback) {
+  std::weak_ptr<bool> alive = alive_;
+  PostTask([alive, section, key, callback](common::AppDB* db) {
+    std::string value;
+    bool found = db->TryGet(section, key, &value);
+    RunOnMainLoop(alive, [callback, found, value]() {
+      callback(found, value);
+    });
+  });
+}
+
+void AsyncAppDB::Set(const std::string& section,
+                     const std::string& key,
+                     const std::string& value) {
+  PostTask([section, key, value](common::AppDB* db) {
+    common::AppDB::Transaction transaction(db);
+    db->Set(section, key, value);
+  });
+}
+
+void AsyncAppDB::Remove(const std::string& section,
+                        const std::string& key) {
+  PostTask([section, key](common::AppDB* db) {
+    common::AppDB::Transaction transaction(db);
+    db->Remove(section, key);
+  });
+}
+
+void AsyncAppDB::PostTask(const Task& task) {
+  g_async_queue_push(queue_, new Task(task));
+}
+
+// static
+gpointer AsyncAppDB::ThreadMain(gpointer user_data) {
+  AsyncAppDB* self = static_cast<AsyncAppDB*>(user_data);
+  // The instance of the main thread isn't safe to use from here, this
+  // thread has a connection of its own.
+  std::unique_ptr<common::AppDB> db(common::AppDB::CreateInstance());
+  while (true) {
+    std::unique_ptr<Task> task(
+        static_cast<Task*>(g_async_queue_pop(self->queue_)));
+    if (!*task)
+      break;
+    (*task)(db.get());
+  }
+  return NULL;
+}
+
+}  // namespace runtime
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+
+#ifndef XWALK_RUNTIME_BROWSER_ASYNC_APP_DB_H_
+#define XWALK_RUNTIME_BROWSER_ASYNC_APP_DB_H_
+
+#include <glib.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace common {
+class AppDB;
+}  // namespace common
+
+namespace runtime {
+
+// Runs AppDB reads and writes on a thread of its own, so that the main loop
+// doesn't stall while another process holds the database lock. Results are
+// delivered on the Ecore main loop, and are dropped once this is deleted.
+// Operations run in the order they were posted.
+class AsyncAppDB {
+ public:
+  typedef std::function<void(bool found, const std::string& value)>
+      GetCallback;
+
+  AsyncAppDB();
+  ~AsyncAppDB();
+
+  void Get(const std::string& section,
+           const std::string& key,
+           GetCallback callback);
+  void Set(const std::string& section,
+           const std::string& key,
+           const std::string& value);
+  void Remove(const std::string& section,
+              const std::string& key);
+
+ private:
+  typedef std::function<void(common::AppDB* db)> Task;
+
+  void PostTask(const Task& task);
+  static gpointer ThreadMain(gpointer user_data);
+
+  GAsyncQueue* queue_;
+  GThread* thread_;
+  std::shared_ptr<bool> alive_;
+};
+
+}  // namespace runtime
+
+#endif  // XWALK_RUNTIME_BROWSER_ASYNC_APP_DB_H_
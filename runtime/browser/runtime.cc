@@ -60,6 +60,8 @@ Runtime::Runtime()
 }
 
 Runtime::~Runtime() {
+  // The prefetcher reads the ApplicationData owned by |application_|
+  prefetcher_.reset();
   if (application_) {
     delete application_;
   }
@@ -83,11 +85,22 @@ bool Runtime::OnCreate() {
     return false;
   }
 
+  // Read the start page and the resources it loaded last time ahead, while
+  // the window and the WebApplication are created.
+  prefetcher_.reset(new common::ResourcePrefetcher(appdata.get()));
+
   // Init AppDB for Runtime
-  common::AppDB* appdb = common::AppDB::GetInstance();
-  appdb->Set(kAppDBRuntimeSection, kAppDBRuntimeName, "xwalk-tizen");
-  appdb->Set(kAppDBRuntimeSection, kAppDBRuntimeAppID, appid);
-  appdb->Remove(kAppDBRuntimeSection, kAppDBRuntimeBundle);
+  // The extension process reads these as soon as it starts, so they are
+  // written out together before it is launched.
+  {
+    common::AppDB* appdb = common::AppDB::GetInstance();
+    common::AppDB::Transaction transaction(appdb);
+    common::AppDB::ValueMap values;
+    values[kAppDBRuntimeName] = "xwalk-tizen";
+    values[kAppDBRuntimeAppID] = appid;
+    appdb->SetMany(kAppDBRuntimeSection, values);
+    appdb->Remove(kAppDBRuntimeSection, kAppDBRuntimeBundle);
+  }
 
   // Exec ExtensionProcess
   ExecExtensionProcess(appid);
@@ -106,12 +119,14 @@ bool Runtime::OnCreate() {
 }
 
 void Runtime::OnTerminate() {
+  common::AppDB::GetInstance()->Flush();
 }
 
 void Runtime::OnPause() {
   if (application_->launched()) {
     application_->Suspend();
   }
+  common::AppDB::GetInstance()->Flush();
 }
 
 void Runtime::OnResume() {
@@ -127,6 +142,7 @@ void Runtime::OnAppControl(app_control_h app_control) {
   common::AppDB* appdb = common::AppDB::GetInstance();
   appdb->Set(kAppDBRuntimeSection, kAppDBRuntimeBundle,
              appcontrol->encoded_bundle());
+  appdb->Flush();
   if (application_->launched()) {
     application_->AppControl(std::move(appcontrol));
   } else {
@@ -18,8 +18,10 @@
 #define XWALK_RUNTIME_BROWSER_RUNTIME_H_
 
 #include <app.h>
+#include <memory>
 #include <string>
 
+#include "common/resource_prefetcher.h"
 #include "runtime/browser/native_window.h"
 #include "runtime/browser/web_application.h"
 
@@ -44,6 +46,7 @@ class Runtime {
  private:
   WebApplication* application_;
   NativeWindow* native_window_;
+  std::unique_ptr<common::ResourcePrefetcher> prefetcher_;
 };
 
 }  // namespace runtime
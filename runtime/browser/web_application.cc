@@ -27,7 +27,6 @@
 #include <vector>
 
 #include "common/application_data.h"
-#include "common/app_db.h"
 #include "common/app_control.h"
 #include "common/command_line.h"
 #include "common/locale_manager.h"
@@ -35,6 +34,7 @@
 #include "common/profiler.h"
 #include "common/resource_manager.h"
 #include "common/string_utils.h"
+#include "runtime/browser/async_app_db.h"
 #include "runtime/browser/native_window.h"
 #include "runtime/browser/notification_manager.h"
 #include "runtime/browser/popup.h"
@@ -212,6 +212,24 @@ static bool ProcessWellKnownScheme(const std::string& url) {
   return true;
 }
 
+// Answers |result_handler| with the remembered decision for |key|, or calls
+// |ask_user| if there is none. The lookup doesn't block the main loop.
+void CheckRememberedPermission(AsyncAppDB* db,
+                               const std::string& key,
+                               std::function<void(bool)> result_handler,
+                               std::function<void()> ask_user) {
+  db->Get(kDBPrivateSection, key,
+    [result_handler, ask_user](bool /*found*/, const std::string& reminder) {
+      if (reminder == "allowed") {
+        result_handler(true);
+      } else if (reminder == "denied") {
+        result_handler(false);
+      } else {
+        ask_user();
+      }
+    });
+}
+
 }  // namespace
 
 WebApplication::WebApplication(
@@ -224,6 +242,7 @@ WebApplication::WebApplication(
       appid_(app_data->app_id()),
       locale_manager_(new common::LocaleManager()),
       app_data_(std::move(app_data)),
+      async_db_(new AsyncAppDB()),
       terminator_(NULL) {
   std::unique_ptr<char, decltype(std::free)*>
     path {app_get_data_path(), std::free};
@@ -664,6 +683,14 @@ void WebApplication::OnConsoleMessage(const std::string& msg, int level) {
 void WebApplication::OnLowMemory() {
   ewk_context_cache_clear(ewk_context_);
   ewk_context_notify_low_memory(ewk_context_);
+
+  // One Way Message, the renderer drops its decrypted resources
+  Ewk_IPC_Wrt_Message_Data* msg = ewk_ipc_wrt_message_data_new();
+  ewk_ipc_wrt_message_data_type_set(msg, "tizen://lowMemory");
+  if (!ewk_ipc_wrt_message_send(ewk_context_, msg)) {
+    LOGGER(ERROR) << "Failed to send low memory message";
+  }
+  ewk_ipc_wrt_message_data_del(msg);
 }
 
 bool WebApplication::OnContextMenuDisabled(WebView* /*view*/) {
@@ -722,86 +749,75 @@ void WebApplication::OnNotificationPermissionRequest(
     WebView*,
     const std::string& url,
     std::function<void(bool)> result_handler) {
-  auto db = common::AppDB::GetInstance();
-  std::string reminder = db->Get(kDBPrivateSection,
-                                 kNotificationPermissionPrefix + url);
-  if (reminder == "allowed") {
-    result_handler(true);
-    return;
-  } else if (reminder == "denied") {
-    result_handler(false);
-    return;
-  }
-
-  // Local Domain: Grant permission if defined, otherwise Popup user prompt.
-  // Remote Domain: Popup user prompt.
-  if (common::utils::StartsWith(url, "file://") &&
-      FindPrivilege(app_data_.get(), kNotificationPrivilege)) {
-    result_handler(true);
-    return;
-  }
-
-  Popup* popup = Popup::CreatePopup(window_);
-  popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
-  popup->SetTitle(popup_string::kPopupTitleWebNotification);
-  popup->SetBody(popup_string::kPopupBodyWebNotification);
-  popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
-  popup->SetResultHandler(
-    [db, result_handler, url](Popup* popup, void* /*user_data*/) {
-      bool result = popup->GetButtonResult();
-      bool remember = popup->GetCheckBoxResult();
-      if (remember) {
-        db->Set(kDBPrivateSection, kNotificationPermissionPrefix + url,
-                result ? "allowed" : "denied");
+  AsyncAppDB* db = async_db_.get();
+  std::string key = kNotificationPermissionPrefix + url;
+  CheckRememberedPermission(db, key, result_handler,
+    [this, db, result_handler, url]() {
+      // Local Domain: Grant permission if defined, otherwise Popup user prompt.
+      // Remote Domain: Popup user prompt.
+      if (common::utils::StartsWith(url, "file://") &&
+          FindPrivilege(app_data_.get(), kNotificationPrivilege)) {
+        result_handler(true);
+        return;
       }
-      result_handler(result);
-    }, this);
-  popup->Show();
+
+      Popup* popup = Popup::CreatePopup(window_);
+      popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
+      popup->SetTitle(popup_string::kPopupTitleWebNotification);
+      popup->SetBody(popup_string::kPopupBodyWebNotification);
+      popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
+      popup->SetResultHandler(
+        [db, result_handler, url](Popup* popup, void* /*user_data*/) {
+          bool result = popup->GetButtonResult();
+          bool remember = popup->GetCheckBoxResult();
+          if (remember) {
+            db->Set(kDBPrivateSection, kNotificationPermissionPrefix + url,
+                    result ? "allowed" : "denied");
+          }
+          result_handler(result);
+        }, this);
+      popup->Show();
+    });
 }
 
 void WebApplication::OnGeolocationPermissionRequest(
     WebView*,
     const std::string& url,
     std::function<void(bool)> result_handler) {
-  auto db = common::AppDB::GetInstance();
-  std::string reminder = db->Get(kDBPrivateSection,
-                                 kGeolocationPermissionPrefix + url);
-  if (reminder == "allowed") {
-    result_handler(true);
-    return;
-  } else if (reminder == "denied") {
-    result_handler(false);
-    return;
-  }
-
-  // Local Domain: Grant permission if defined, otherwise block execution.
-  // Remote Domain: Popup user prompt if defined, otherwise block execution.
-  if (!FindPrivilege(app_data_.get(), kLocationPrivilege)) {
-    result_handler(false);
-    return;
-  }
-
-  if (common::utils::StartsWith(url, "file://")) {
-    result_handler(true);
-    return;
-  }
+  AsyncAppDB* db = async_db_.get();
+  std::string key = kGeolocationPermissionPrefix + url;
+  CheckRememberedPermission(db, key, result_handler,
+    [this, db, result_handler, url]() {
+      // Local Domain: Grant permission if defined, otherwise block execution.
+      // Remote Domain: Popup user prompt if defined, otherwise block
+      // execution.
+      if (!FindPrivilege(app_data_.get(), kLocationPrivilege)) {
+        result_handler(false);
+        return;
+      }
 
-  Popup* popup = Popup::CreatePopup(window_);
-  popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
-  popup->SetTitle(popup_string::kPopupTitleGeoLocation);
-  popup->SetBody(popup_string::kPopupBodyGeoLocation);
-  popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
-  popup->SetResultHandler(
-    [db, result_handler, url](Popup* popup, void* /*user_data*/) {
-      bool result = popup->GetButtonResult();
-      bool remember = popup->GetCheckBoxResult();
-      if (remember) {
-        db->Set(kDBPrivateSection, kGeolocationPermissionPrefix + url,
-                result ? "allowed" : "denied");
+      if (common::utils::StartsWith(url, "file://")) {
+        result_handler(true);
+        return;
       }
-      result_handler(result);
-    }, this);
-  popup->Show();
+
+      Popup* popup = Popup::CreatePopup(window_);
+      popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
+      popup->SetTitle(popup_string::kPopupTitleGeoLocation);
+      popup->SetBody(popup_string::kPopupBodyGeoLocation);
+      popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
+      popup->SetResultHandler(
+        [db, result_handler, url](Popup* popup, void* /*user_data*/) {
+          bool result = popup->GetButtonResult();
+          bool remember = popup->GetCheckBoxResult();
+          if (remember) {
+            db->Set(kDBPrivateSection, kGeolocationPermissionPrefix + url,
+                    result ? "allowed" : "denied");
+          }
+          result_handler(result);
+        }, this);
+      popup->Show();
+    });
 }
 
 
@@ -809,41 +825,35 @@ void WebApplication::OnQuotaExceed(
     WebView*,
     const std::string& url,
     std::function<void(bool)> result_handler) {
-  auto db = common::AppDB::GetInstance();
-  std::string reminder = db->Get(kDBPrivateSection,
-                                 kQuotaPermissionPrefix + url);
-  if (reminder == "allowed") {
-    result_handler(true);
-    return;
-  } else if (reminder == "denied") {
-    result_handler(false);
-    return;
-  }
-
-  // Local Domain: Grant permission if defined, otherwise Popup user prompt.
-  // Remote Domain: Popup user prompt.
-  if (common::utils::StartsWith(url, "file://") &&
-      FindPrivilege(app_data_.get(), kStoragePrivilege)) {
-    result_handler(true);
-    return;
-  }
-
-  Popup* popup = Popup::CreatePopup(window_);
-  popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
-  popup->SetTitle(popup_string::kPopupTitleWebStorage);
-  popup->SetBody(popup_string::kPopupBodyWebStorage);
-  popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
-  popup->SetResultHandler(
-    [db, result_handler, url](Popup* popup, void* /*user_data*/) {
-      bool result = popup->GetButtonResult();
-      bool remember = popup->GetCheckBoxResult();
-      if (remember) {
-        db->Set(kDBPrivateSection, kQuotaPermissionPrefix + url,
-                result ? "allowed" : "denied");
+  AsyncAppDB* db = async_db_.get();
+  std::string key = kQuotaPermissionPrefix + url;
+  CheckRememberedPermission(db, key, result_handler,
+    [this, db, result_handler, url]() {
+      // Local Domain: Grant permission if defined, otherwise Popup user prompt.
+      // Remote Domain: Popup user prompt.
+      if (common::utils::StartsWith(url, "file://") &&
+          FindPrivilege(app_data_.get(), kStoragePrivilege)) {
+        result_handler(true);
+        return;
       }
-      result_handler(result);
-    }, this);
-  popup->Show();
+
+      Popup* popup = Popup::CreatePopup(window_);
+      popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
+      popup->SetTitle(popup_string::kPopupTitleWebStorage);
+      popup->SetBody(popup_string::kPopupBodyWebStorage);
+      popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
+      popup->SetResultHandler(
+        [db, result_handler, url](Popup* popup, void* /*user_data*/) {
+          bool result = popup->GetButtonResult();
+          bool remember = popup->GetCheckBoxResult();
+          if (remember) {
+            db->Set(kDBPrivateSection, kQuotaPermissionPrefix + url,
+                    result ? "allowed" : "denied");
+          }
+          result_handler(result);
+        }, this);
+      popup->Show();
+    });
 }
 
 void WebApplication::OnAuthenticationRequest(
@@ -877,78 +887,67 @@ void WebApplication::OnCertificateAllowRequest(
       const std::string& /*url*/,
       const std::string& pem,
       std::function<void(bool allow)> result_handler) {
-  auto db = common::AppDB::GetInstance();
-  std::string reminder = db->Get(kDBPrivateSection,
-                                 kCertificateAllowPrefix + pem);
-  if (reminder == "allowed") {
-    result_handler(true);
-    return;
-  } else if (reminder == "denied") {
-    result_handler(false);
-    return;
-  }
-
-  Popup* popup = Popup::CreatePopup(window_);
-  popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
-  popup->SetTitle(popup_string::kPopupTitleCert);
-  popup->SetBody(popup_string::kPopupBodyCert);
-  popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
-  popup->SetResultHandler(
-    [db, result_handler, pem](Popup* popup, void* /*user_data*/) {
-      bool result = popup->GetButtonResult();
-      bool remember = popup->GetCheckBoxResult();
-      if (remember) {
-        db->Set(kDBPrivateSection, kCertificateAllowPrefix + pem,
-                result ? "allowed" : "denied");
-      }
-      result_handler(result);
-    }, this);
-  popup->Show();
+  AsyncAppDB* db = async_db_.get();
+  std::string key = kCertificateAllowPrefix + pem;
+  CheckRememberedPermission(db, key, result_handler,
+    [this, db, result_handler, pem]() {
+      Popup* popup = Popup::CreatePopup(window_);
+      popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
+      popup->SetTitle(popup_string::kPopupTitleCert);
+      popup->SetBody(popup_string::kPopupBodyCert);
+      popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
+      popup->SetResultHandler(
+        [db, result_handler, pem](Popup* popup, void* /*user_data*/) {
+          bool result = popup->GetButtonResult();
+          bool remember = popup->GetCheckBoxResult();
+          if (remember) {
+            db->Set(kDBPrivateSection, kCertificateAllowPrefix + pem,
+                    result ? "allowed" : "denied");
+          }
+          result_handler(result);
+        }, this);
+      popup->Show();
+    });
 }
 
 void WebApplication::OnUsermediaPermissionRequest(
       WebView*,
       const std::string& url,
       std::function<void(bool)> result_handler) {
-  auto db = common::AppDB::GetInstance();
-  std::string reminder = db->Get(kDBPrivateSection,
-                                 kUsermediaPermissionPrefix + url);
-  if (reminder == "allowed") {
-    result_handler(true);
-    return;
-  } else if (reminder == "denied") {
-    result_handler(false);
-    return;
-  }
-
-  // Local Domain: Grant permission if defined, otherwise block execution.
-  // Remote Domain: Popup user prompt if defined, otherwise block execution.
-  if (!FindPrivilege(app_data_.get(), kUsermediaPrivilege)) {
-    result_handler(false);
-    return;
-  }
-
-  if (common::utils::StartsWith(url, "file://")) {
-    result_handler(true);
-    return;
-  }
+  AsyncAppDB* db = async_db_.get();
+  std::string key = kUsermediaPermissionPrefix + url;
+  CheckRememberedPermission(db, key, result_handler,
+    [this, db, result_handler, url]() {
+      // Local Domain: Grant permission if defined, otherwise block execution.
+      // Remote Domain: Popup user prompt if defined, otherwise block
+      // execution.
+      if (!FindPrivilege(app_data_.get(), kUsermediaPrivilege)) {
+        result_handler(false);
+        return;
+      }
 
-  Popup* popup = Popup::CreatePopup(window_);
-  popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
-  popup->SetTitle(popup_string::kPopupTitleUserMedia);
-  popup->SetBody(popup_string::kPopupBodyUserMedia);
-  popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
-  popup->SetResultHandler(
-    [db, result_handler, url](Popup* popup, void* /*user_data*/) {
-      bool result = popup->GetButtonResult();
-      bool remember = popup->GetCheckBoxResult();
-      if (remember) {
-        db->Set(kDBPrivateSection, kUsermediaPermissionPrefix + url,
-                result ? "allowed" : "denied");
+      if (common::utils::StartsWith(url, "file://")) {
+        result_handler(true);
+        return;
       }
-      result_handler(result);
-    }, this);
-  popup->Show();
+
+      Popup* popup = Popup::CreatePopup(window_);
+      popup->SetButtonType(Popup::ButtonType::AllowDenyButton);
+      popup->SetTitle(popup_string::kPopupTitleUserMedia);
+      popup->SetBody(popup_string::kPopupBodyUserMedia);
+      popup->SetCheckBox(popup_string::kPopupCheckRememberPreference);
+      popup->SetResultHandler(
+        [db, result_handler, url](Popup* popup, void* /*user_data*/) {
+          bool result = popup->GetButtonResult();
+          bool remember = popup->GetCheckBoxResult();
+          if (remember) {
+            db->Set(kDBPrivateSection, kUsermediaPermissionPrefix + url,
+                    result ? "allowed" : "denied");
+          }
+          result_handler(result);
+        }, this);
+      popup->Show();
+    });
 }
 
 }  // namespace runtime
@@ -34,6 +34,7 @@ class ResourceManager;
 }  // namespace common
 
 namespace runtime {
+class AsyncAppDB;
 class NativeWindow;
 
 class WebApplication : public WebView::EventListener {
@@ -119,6 +120,7 @@ class WebApplication : public WebView::EventListener {
   std::unique_ptr<common::LocaleManager> locale_manager_;
   std::unique_ptr<common::ApplicationData> app_data_;
   std::unique_ptr<common::ResourceManager> resource_manager_;
+  std::unique_ptr<AsyncAppDB> async_db_;
   std::function<void(void)> terminator_;
   int security_model_version_;
   std::string csp_rule_;
@@ -15,7 +15,10 @@
  */
 
 #include <Ecore.h>
+#include <errno.h>
 #include <ewk_ipc_message.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <v8.h>
 
@@ -27,6 +30,7 @@
 #include "common/logger.h"
 #include "common/profiler.h"
 #include "common/resource_manager.h"
+#include "common/resource_prefetcher.h"
 #include "common/string_utils.h"
 #include "extensions/renderer/runtime_ipc_client.h"
 #include "extensions/renderer/widget_module.h"
@@ -34,6 +38,14 @@
 #include "extensions/renderer/xwalk_module_system.h"
 
 namespace runtime {
+
+namespace {
+
+// Byte budget of the decrypted resource cache, overrides the default
+const char* kDecryptedCacheBudgetKey = "WRT_DECRYPTED_CACHE_BUDGET";
+
+}  // namespace
+
 class BundleGlobalData {
  public :
   static BundleGlobalData* GetInstance() {
@@ -54,6 +66,20 @@ class BundleGlobalData {
                             locale_manager_.get()));
     resource_manager_->set_base_resource_path(
         app_data_->application_path());
+    const char* cache_budget = getenv(kDecryptedCacheBudgetKey);
+    if (cache_budget != NULL) {
+      // strtoul() takes a sign, so "-1" would become the largest budget.
+      char* end = NULL;
+      errno = 0;
+      unsigned long budget = strtoul(cache_budget, &end, 10);  // NOLINT
+      if (end == cache_budget || *end != '\0' || errno != 0 ||
+          strchr(cache_budget, '-') != NULL) {
+        LOGGER(WARN) << "Ignoring invalid " << kDecryptedCacheBudgetKey
+                     << " : " << cache_budget;
+      } else {
+        resource_manager_->set_decrypted_cache_budget(budget);
+      }
+    }
 
     auto widgetdb = extensions::WidgetPreferenceDB::GetInstance();
     widgetdb->Initialize(app_data_.get(),
@@ -64,12 +90,17 @@ class BundleGlobalData {
     return resource_manager_.get();
   }
 
+  common::ResourceRecorder* resource_recorder() {
+    return &resource_recorder_;
+  }
+
  private:
   BundleGlobalData() {}
   ~BundleGlobalData() {}
   std::unique_ptr<common::ResourceManager> resource_manager_;
   std::unique_ptr<common::LocaleManager> locale_manager_;
   std::unique_ptr<common::ApplicationData> app_data_;
+  common::ResourceRecorder resource_recorder_;
 };
 }  //  namespace runtime
 
@@ -124,6 +155,9 @@ extern "C" void DynamicPluginStopSession(
   extensions::XWalkExtensionRendererController& controller =
       extensions::XWalkExtensionRendererController::GetInstance();
   controller.WillReleaseScriptContext(context);
+
+  // Pages that load few resources are stored when the first one is left
+  runtime::BundleGlobalData::GetInstance()->resource_recorder()->Save();
 }
 
 extern "C" void DynamicUrlParsing(
@@ -145,6 +179,8 @@ extern "C" void DynamicUrlParsing(
   if (common::utils::StartsWith(*old_url, "file:/") ||
       common::utils::StartsWith(*old_url, "app:/")) {
     *new_url = res_manager->GetLocalizedPath(*old_url);
+    runtime::BundleGlobalData::GetInstance()->resource_recorder()->Record(
+        *new_url);
   } else {
     *new_url = *old_url;
   }
@@ -160,6 +196,18 @@ extern "C" void DynamicDatabaseAttach(int /*attach*/) {
 
 extern "C" void DynamicOnIPCMessage(const Ewk_IPC_Wrt_Message_Data& data) {
   LOGGER(DEBUG) << "InjectedBundle::DynamicOnIPCMessage !!";
+  Eina_Stringshare* msg_type = ewk_ipc_wrt_message_data_type_get(&data);
+  bool low_memory = msg_type != NULL && !strcmp(msg_type, "tizen://lowMemory");
+  eina_stringshare_del(msg_type);
+  if (low_memory) {
+    // One Way Message
+    auto res_manager =
+        runtime::BundleGlobalData::GetInstance()->resource_manager();
+    if (res_manager != NULL)
+      res_manager->ClearDecryptedCache();
+    return;
+  }
+
   extensions::RuntimeIPCClient* rc =
       extensions::RuntimeIPCClient::GetInstance();
   rc->HandleMessageFromRuntime(&data);
@@ -16,6 +16,8 @@
         'browser/runtime_process.cc',
         'browser/runtime.h',
         'browser/runtime.cc',
+        'browser/async_app_db.h',
+        'browser/async_app_db.cc',
         'browser/native_window.h',
         'browser/native_window.cc',
         'browser/native_app_window.h',
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2015 Samsung Electronics Co., Ltd. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+# Generates the extension to MIME type table of common/mime_table.h from the
+# globs2 file of the shared-mime-info database.
+#
+# Usage: generate_mime_table.py <globs2 file> <output .cc file>
+
+import sys
+
+TEMPLATE = """\
+// Generated by tools/generate_mime_table.py from
+// %s. DO NOT EDIT!
+
+#include "common/mime_table.h"
+
+namespace common {
+
+const MimeTableEntry kMimeTable[] = {
+%s
+};
+
+const size_t kMimeTableSize = sizeof(kMimeTable) / sizeof(kMimeTable[0]);
+
+}  // namespace common
+"""
+
+
+def read_globs(path):
+  # extension -> (weight, set of MIME types)
+  globs = {}
+  # extensions that have case sensitive globs, left to aul
+  case_sensitive = set()
+  for line in open(path):
+    line = line.strip()
+    if not line or line.startswith('#'):
+      continue
+    fields = line.split(':')
+    if len(fields) < 3:
+      continue
+    weight, mime, glob = int(fields[0]), fields[1], fields[2]
+    flags = fields[3].split(',') if len(fields) > 3 else []
+    # only plain "*.ext" globs
+    if not glob.startswith('*.') or any(c in glob[2:] for c in '*?[\\'):
+      continue
+    extension = glob[2:].lower()
+    if 'cs' in flags:
+      case_sensitive.add(extension)
+      continue
+    best = globs.get(extension)
+    if best is None or weight > best[0]:
+      globs[extension] = (weight, set([mime]))
+    elif weight == best[0]:
+      best[1].add(mime)
+  return globs, case_sensitive
+
+
+def main():
+  if len(sys.argv) != 3:
+    sys.stderr.write('Usage: %s <globs2 file> <output file>\n' % sys.argv[0])
+    return 1
+
+  globs, case_sensitive = read_globs(sys.argv[1])
+  entries = []
+  for extension in sorted(globs):
+    mimes = globs[extension][1]
+    # ties are resolved by sniffing the content
+    if len(mimes) != 1 or extension in case_sensitive:
+      continue
+    entries.append('  {"%s", "%s"},' % (extension, list(mimes)[0]))
+
+  output = open(sys.argv[2], 'w')
+  output.write(TEMPLATE % (sys.argv[1], '\n'.join(entries)))
+  output.close()
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())